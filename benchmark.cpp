@@ -0,0 +1,214 @@
+/**
+ * @file benchmark.cpp
+ * @brief Mikrobenchmarki operacji klasy matrix
+ *
+ * Dla każdego rozmiaru n (potęgi dwójki od --min do --max) i każdej operacji
+ * mierzony jest czas jednego wywołania, przepustowość w GFLOP/s (liczba
+ * operacji arytmetycznych lub elementów na sekundę) i ilość przesłanych
+ * bajtów. Wyniki wypisywane są jako tabela, a z opcją --json także do pliku
+ * JSON, który można porównywać między wersjami.
+ *
+ * Użycie:
+ * @code
+ * matrix_benchmark [--min N] [--max N] [--czas MS] [--filtr NAZWA] [--json PLIK]
+ * @endcode
+ */
+
+#include "matrix.h"
+#include "simd.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+    /**
+     * @class licznik_znakow
+     * @brief Bufor strumienia, który zlicza zapisane znaki i je odrzuca
+     */
+    class licznik_znakow : public std::streambuf {
+    public:
+        std::uint64_t znaki = 0; ///< Liczba zapisanych znaków
+
+    protected:
+        int_type overflow(int_type c) override {
+            ++znaki;
+            return c;
+        }
+
+        std::streamsize xsputn(const char*, std::streamsize ile) override {
+            znaki += static_cast<std::uint64_t>(ile);
+            return ile;
+        }
+    };
+
+    /**
+     * @struct operacja
+     * @brief Mierzona operacja wraz z modelem liczby działań i przesłanych bajtów
+     */
+    struct operacja {
+        string nazwa;                                  ///< Nazwa w wynikach
+        function<void(matrix& a, matrix& b)> wykonaj;  ///< Jedno wywołanie operacji
+        function<double(double n)> dzialania;          ///< Liczba działań na wywołanie
+        function<double(double n)> bajty;              ///< Bajty przesłane na wywołanie
+    };
+
+    /**
+     * @struct wynik
+     * @brief Wynik pomiaru jednej operacji dla jednego rozmiaru
+     */
+    struct wynik {
+        string nazwa;           ///< Nazwa operacji
+        int n;                  ///< Rozmiar macierzy
+        long long iteracje;     ///< Liczba zmierzonych wywołań
+        double ns_na_operacje;  ///< Średni czas wywołania
+        double gflops;          ///< Działania na sekundę (×10^9)
+        double bajty;           ///< Bajty przesłane na wywołanie
+        double gb_na_s;         ///< Przepustowość pamięci (×10^9 B/s)
+    };
+
+    volatile long long ujscie = 0; ///< Zapobiega usunięciu mierzonych obliczeń przez kompilator
+
+    /// Dodaje wynik operacji do ujścia
+    void zuzyj(long long x) { ujscie = ujscie + x; }
+
+    double element(double n) { return n * n; }
+    double bajty_odczyt_zapis(double n) { return 2 * n * n * sizeof(int); }
+    double bajty_zapis(double n) { return n * n * sizeof(int); }
+
+    vector<operacja> operacje() {
+        auto znaki = make_shared<licznik_znakow>();
+        auto strumien = make_shared<ostream>(znaki.get());
+        return {
+            { "mnozenie", [](matrix& a, matrix& b) { matrix c = a * b; zuzyj(c.pokaz(0, 0)); },
+              [](double n) { return 2 * n * n * n; }, [](double n) { return 3 * n * n * sizeof(int); } },
+            { "potega_16", [](matrix& a, matrix&) { matrix c = a.potega(16); zuzyj(c.pokaz(0, 0)); },
+              [](double n) { return 4 * 2 * n * n * n; }, [](double n) { return 4 * 3 * n * n * sizeof(int); } },
+            { "odwroc", [](matrix& a, matrix&) { a.odwroc(); }, element, bajty_odczyt_zapis },
+            { "odwrocona", [](matrix& a, matrix&) { matrix c = a.odwrocona(); zuzyj(c.pokaz(0, 0)); }, element, bajty_odczyt_zapis },
+            { "dodaj_skalar", [](matrix& a, matrix&) { matrix c = a + 3; zuzyj(c.pokaz(0, 0)); }, element, bajty_odczyt_zapis },
+            { "mnoz_skalar", [](matrix& a, matrix&) { matrix c = a * 3; zuzyj(c.pokaz(0, 0)); }, element, bajty_odczyt_zapis },
+            { "odejmij_od_skalara", [](matrix& a, matrix&) { matrix c = 3 - a; zuzyj(c.pokaz(0, 0)); }, element, bajty_odczyt_zapis },
+            { "dodaj_skalar_w_miejscu", [](matrix& a, matrix&) { a += 1; }, element, bajty_odczyt_zapis },
+            { "postinkrementacja", [](matrix& a, matrix&) { matrix c = a++; zuzyj(c.pokaz(0, 0)); }, element,
+              [](double n) { return 3 * n * n * sizeof(int); } },
+            { "dodaj_macierze", [](matrix& a, matrix& b) { matrix c = a + b; zuzyj(c.pokaz(0, 0)); }, element,
+              [](double n) { return 3 * n * n * sizeof(int); } },
+            { "rowne", [](matrix& a, matrix&) { matrix c = a; zuzyj(a == c); }, element,
+              [](double n) { return 4 * n * n * sizeof(int); } },
+            { "wieksze", [](matrix& a, matrix& b) { zuzyj(b > a); }, element, bajty_odczyt_zapis },
+            { "mniejsze", [](matrix& a, matrix& b) { zuzyj(a < b); }, element, bajty_odczyt_zapis },
+            { "skrot", [](matrix& a, matrix&) { a.data(); zuzyj(static_cast<long long>(a.skrot())); }, element,
+              [](double n) { return n * n * sizeof(int); } },
+            { "losuj", [](matrix& a, matrix&) { a.losuj(); }, element, bajty_zapis },
+            { "losuj_z_ziarnem", [](matrix& a, matrix&) { a.losuj(1000, 42); }, element, bajty_zapis },
+            { "szachownica", [](matrix& a, matrix&) { a.szachownica(); }, element, bajty_zapis },
+            { "przekatna", [](matrix& a, matrix&) { a.przekatna(); }, element, bajty_zapis },
+            { "wypisz", [znaki, strumien](matrix& a, matrix&) { *strumien << a; zuzyj(static_cast<long long>(znaki->znaki)); },
+              element, [](double n) { return n * n * (sizeof(int) + 2); } },
+        };
+    }
+
+    /**
+     * @brief Mierzy operację, podwajając liczbę wywołań aż pomiar trwa co najmniej czas_ms
+     */
+    wynik zmierz(const operacja& op, int n, double czas_ms) {
+        using zegar = chrono::steady_clock;
+        matrix a(n), b(n);
+        a.losuj(9, 1);
+        b = a + 1;
+        op.wykonaj(a, b); // rozgrzewka
+
+        long long iteracje = 1;
+        double ns = 0;
+        while (true) {
+            auto start = zegar::now();
+            for (long long i = 0; i < iteracje; ++i) op.wykonaj(a, b);
+            ns = chrono::duration<double, nano>(zegar::now() - start).count();
+            if (ns >= czas_ms * 1e6 || iteracje >= (1LL << 40)) break;
+            iteracje *= 2;
+        }
+
+        wynik w;
+        w.nazwa = op.nazwa;
+        w.n = n;
+        w.iteracje = iteracje;
+        w.ns_na_operacje = ns / iteracje;
+        w.gflops = op.dzialania(n) / w.ns_na_operacje;
+        w.bajty = op.bajty(n);
+        w.gb_na_s = w.bajty / w.ns_na_operacje;
+        return w;
+    }
+
+    void zapisz_json(const string& sciezka, const vector<wynik>& wyniki) {
+        ofstream plik(sciezka);
+        if (!plik) throw logic_error("Nie mozna otworzyc pliku: " + sciezka);
+        plik << "{\n  \"watki\": " << matrix::liczba_watkow()
+            << ",\n  \"isa\": \"" << simd::nazwa(simd::poziom()) << "\",\n  \"wyniki\": [\n";
+        plik << setprecision(6);
+        for (size_t i = 0; i < wyniki.size(); ++i) {
+            const wynik& w = wyniki[i];
+            plik << "    { \"operacja\": \"" << w.nazwa << "\", \"n\": " << w.n
+                << ", \"iteracje\": " << w.iteracje << ", \"ns_na_operacje\": " << w.ns_na_operacje
+                << ", \"gflops\": " << w.gflops << ", \"bajty\": " << w.bajty
+                << ", \"gb_na_s\": " << w.gb_na_s << " }" << (i + 1 < wyniki.size() ? "," : "") << "\n";
+        }
+        plik << "  ]\n}\n";
+    }
+}
+
+/**
+ * @brief Uruchamia benchmarki zgodnie z argumentami wiersza poleceń
+ * @return 0 po udanym pomiarze, 1 przy błędnych argumentach lub błędzie zapisu
+ */
+int main(int argc, char** argv) {
+    int min_n = 8, max_n = 4096;
+    double czas_ms = 100;
+    string filtr, sciezka_json;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool ma_wartosc = i + 1 < argc;
+        if (arg == "--min" && ma_wartosc) min_n = atoi(argv[++i]);
+        else if (arg == "--max" && ma_wartosc) max_n = atoi(argv[++i]);
+        else if (arg == "--czas" && ma_wartosc) czas_ms = atof(argv[++i]);
+        else if (arg == "--filtr" && ma_wartosc) filtr = argv[++i];
+        else if (arg == "--json" && ma_wartosc) sciezka_json = argv[++i];
+        else {
+            cerr << "Uzycie: " << argv[0] << " [--min N] [--max N] [--czas MS] [--filtr NAZWA] [--json PLIK]" << endl;
+            return 1;
+        }
+    }
+
+    try {
+        vector<wynik> wyniki;
+        cout << left << setw(24) << "operacja" << right << setw(6) << "n" << setw(16) << "ns/op"
+            << setw(12) << "GFLOP/s" << setw(12) << "GB/s" << endl;
+        for (const operacja& op : operacje()) {
+            if (!filtr.empty() && op.nazwa.find(filtr) == string::npos) continue;
+            for (int n = min_n; n <= max_n; n *= 2) {
+                wynik w = zmierz(op, n, czas_ms);
+                cout << left << setw(24) << w.nazwa << right << setw(6) << w.n << fixed << setprecision(1)
+                    << setw(16) << w.ns_na_operacje << setprecision(3) << setw(12) << w.gflops
+                    << setw(12) << w.gb_na_s << defaultfloat << endl;
+                wyniki.push_back(w);
+            }
+        }
+        if (!sciezka_json.empty()) zapisz_json(sciezka_json, wyniki);
+    }
+    catch (exception& e) {
+        cerr << "BLAD: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
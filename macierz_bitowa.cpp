@@ -0,0 +1,329 @@
+/**
+ * @file macierz_bitowa.cpp
+ * @brief Implementacja macierzy logicznej upakowanej bitowo
+ */
+
+#include "macierz_bitowa.h"
+#include "watki.h"
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+
+/**
+ * @def MATRIX_KLONY_POPCNT
+ * @brief Kompiluje funkcję w wariancie z instrukcją popcnt i bazowym
+ * @details Bez -mpopcnt std::popcount jest wywołaniem funkcji bibliotecznej;
+ * loader wybiera wariant popcnt, gdy procesor go obsługuje.
+ */
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__) && !defined(__SANITIZE_THREAD__)
+#define MATRIX_KLONY_POPCNT __attribute__((target_clones("popcnt", "default")))
+#else
+#define MATRIX_KLONY_POPCNT
+#endif
+
+namespace {
+
+    constexpr int GRUPA = 8;                 ///< Wiersze B na tablicę czterech Rosjan (2^8 sum)
+    constexpr int SLOWA_PASA = 8;            ///< Słowa kolumn wyniku na pas (tablica 256×8 słów mieści się w L1)
+    constexpr int WIERSZE_PASA = 64;         ///< Wiersze wyniku na zadanie iloczynu zliczającego
+    constexpr int PROG_ROWNOLEGLY = 256;     ///< Minimalne n, od którego iloczyny dzielone są na wątki
+
+    /**
+     * @brief Sprawdza zgodność rozmiarów argumentów działania
+     * @throw std::logic_error Jeśli rozmiary są różne
+     */
+    void sprawdz_rozmiary(int n1, int n2) {
+        if (n1 != n2) throw std::logic_error("Macierze muszą mieć ten sam rozmiar");
+    }
+
+    /**
+     * @brief Wykonuje zadanie(i) dla i = 0..liczba-1, w puli wątków dla dużych n
+     */
+    void rozdziel(int n, int liczba, const std::function<void(int)>& zadanie) {
+        if (n < PROG_ROWNOLEGLY || watki::liczba_watkow() == 1) {
+            for (int i = 0; i < liczba; ++i) zadanie(i);
+            return;
+        }
+        watki::globalna()->rownolegle_dla(liczba, zadanie);
+    }
+
+    /**
+     * @brief Transponuje blok 64×64 bity: bit c słowa r przechodzi na bit r słowa c
+     * @details Zamienia ćwiartki bloków 32×32, potem 16×16 itd. aż do 1×1.
+     */
+    void transponuj_64(std::uint64_t x[64]) {
+        std::uint64_t maska = 0x00000000FFFFFFFFull;
+        for (int j = 32; j != 0; j >>= 1, maska ^= maska << j) {
+            for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+                std::uint64_t t = ((x[k] >> j) ^ x[k | j]) & maska;
+                x[k] ^= t << j;
+                x[k | j] ^= t;
+            }
+        }
+    }
+
+    /**
+     * @brief Zwraca liczbę wspólnych jedynek dwóch ciągów słów
+     */
+    MATRIX_KLONY_POPCNT
+    int wspolne_jedynki(const std::uint64_t* a, const std::uint64_t* b, int slowa) {
+        int suma = 0;
+        for (int w = 0; w < slowa; ++w) suma += std::popcount(a[w] & b[w]);
+        return suma;
+    }
+
+    /**
+     * @brief Zwraca liczbę jedynek w ciągu słów
+     */
+    MATRIX_KLONY_POPCNT
+    std::size_t jedynki(const std::vector<std::uint64_t>& bity) {
+        std::size_t suma = 0;
+        for (std::uint64_t s : bity) suma += std::popcount(s);
+        return suma;
+    }
+}
+
+// ==================== Konstruktory ====================
+
+/**
+ * @brief Konstruktor domyślny - tworzy pustą macierz o rozmiarze 0x0
+ */
+macierz_bitowa::macierz_bitowa(void) : n(0), slowa(0) {}
+
+/**
+ * @brief Konstruktor parametryczny - tworzy macierz n×n wypełnioną zerami
+ * @param n Rozmiar macierzy kwadratowej
+ * @throw std::logic_error Jeśli n < 0
+ */
+macierz_bitowa::macierz_bitowa(int n) : n(n), slowa((n + 63) / 64) {
+    if (n < 0) throw std::logic_error("Rozmiar macierzy nie moze byc ujemny");
+    bity.assign(static_cast<std::size_t>(n) * slowa, 0);
+}
+
+/**
+ * @brief Konstruktor konwertujący macierz liczb (element niezerowy daje jedynkę)
+ * @param m Macierz źródłowa
+ */
+macierz_bitowa::macierz_bitowa(const matrix& m) : macierz_bitowa(m.getSize()) {
+    for (int i = 0; i < n; ++i) {
+        std::span<const int> r = m.row(i);
+        std::uint64_t* w = wiersz(i);
+        for (int j = 0; j < n; ++j)
+            w[j / 64] |= static_cast<std::uint64_t>(r[j] != 0) << (j % 64);
+    }
+}
+
+/**
+ * @brief Tworzy macierz liczb z elementami 0 i 1
+ * @return Nowa macierz n×n
+ */
+matrix macierz_bitowa::na_macierz(void) const {
+    matrix wynik(n);
+    for (int i = 0; i < n; ++i) {
+        std::span<int> r = wynik.wiersz_do_zapisu(i);
+        const std::uint64_t* w = wiersz(i);
+        for (int j = 0; j < n; ++j) r[j] = static_cast<int>((w[j / 64] >> (j % 64)) & 1);
+    }
+    return wynik;
+}
+
+/**
+ * @brief Tworzy macierz jednostkową n×n
+ * @param n Rozmiar macierzy
+ * @return Macierz z jedynkami na głównej przekątnej
+ */
+macierz_bitowa macierz_bitowa::jednostkowa(int n) {
+    macierz_bitowa wynik(n);
+    for (int i = 0; i < n; ++i) wynik.wiersz(i)[i / 64] = std::uint64_t(1) << (i % 64);
+    return wynik;
+}
+
+// ==================== Dostęp ====================
+
+/**
+ * @brief Zwraca wartość elementu
+ * @param x Indeks wiersza
+ * @param y Indeks kolumny
+ * @return Wartość bitu (x, y)
+ * @throw std::logic_error Jeśli współrzędne są poza zakresem
+ */
+bool macierz_bitowa::pokaz(int x, int y) const {
+    if (x < 0 || y < 0 || x >= n || y >= n) throw std::logic_error("Zle wspolrzedne macierzy");
+    return (wiersz(x)[y / 64] >> (y % 64)) & 1;
+}
+
+/**
+ * @brief Ustawia wartość elementu
+ * @param x Indeks wiersza
+ * @param y Indeks kolumny
+ * @param wartosc Nowa wartość bitu
+ * @return Referencja do bieżącej macierzy
+ * @throw std::logic_error Jeśli współrzędne są poza zakresem
+ */
+macierz_bitowa& macierz_bitowa::wstaw(int x, int y, bool wartosc) {
+    if (x < 0 || y < 0 || x >= n || y >= n) throw std::logic_error("Zle wspolrzedne macierzy");
+    std::uint64_t bit = std::uint64_t(1) << (y % 64);
+    std::uint64_t& slowo = wiersz(x)[y / 64];
+    slowo = wartosc ? (slowo | bit) : (slowo & ~bit);
+    return *this;
+}
+
+/**
+ * @brief Zwraca liczbę jedynek w macierzy
+ * @return Liczba niezerowych elementów
+ */
+std::size_t macierz_bitowa::niezerowe() const {
+    return jedynki(bity);
+}
+
+// ==================== Działania element po elemencie ====================
+
+/**
+ * @brief AND element po elemencie, słowami 64-bitowymi
+ * @param m Drugi argument
+ * @return Referencja do bieżącej macierzy
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+macierz_bitowa& macierz_bitowa::operator&=(const macierz_bitowa& m) {
+    sprawdz_rozmiary(n, m.n);
+    for (std::size_t i = 0; i < bity.size(); ++i) bity[i] &= m.bity[i];
+    return *this;
+}
+
+/**
+ * @brief OR element po elemencie, słowami 64-bitowymi
+ * @param m Drugi argument
+ * @return Referencja do bieżącej macierzy
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+macierz_bitowa& macierz_bitowa::operator|=(const macierz_bitowa& m) {
+    sprawdz_rozmiary(n, m.n);
+    for (std::size_t i = 0; i < bity.size(); ++i) bity[i] |= m.bity[i];
+    return *this;
+}
+
+/**
+ * @brief XOR element po elemencie, słowami 64-bitowymi
+ * @param m Drugi argument
+ * @return Referencja do bieżącej macierzy
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+macierz_bitowa& macierz_bitowa::operator^=(const macierz_bitowa& m) {
+    sprawdz_rozmiary(n, m.n);
+    for (std::size_t i = 0; i < bity.size(); ++i) bity[i] ^= m.bity[i];
+    return *this;
+}
+
+// ==================== Iloczyny ====================
+
+/**
+ * @brief Zwraca transpozycję macierzy
+ * @details Macierz przechodzona jest blokami 64×64 bity, transponowanymi
+ * w rejestrach przez transponuj_64.
+ * @return Nowa macierz A^T
+ */
+macierz_bitowa macierz_bitowa::odwrocona(void) const {
+    macierz_bitowa wynik(n);
+    std::uint64_t blok[64];
+    for (int bi = 0; bi < slowa; ++bi) {
+        int wierszy = std::min(64, n - bi * 64);
+        for (int bj = 0; bj < slowa; ++bj) {
+            for (int r = 0; r < 64; ++r) blok[r] = r < wierszy ? wiersz(bi * 64 + r)[bj] : 0;
+            transponuj_64(blok);
+            int kolumn = std::min(64, n - bj * 64);
+            for (int r = 0; r < kolumn; ++r) wynik.wiersz(bj * 64 + r)[bi] = blok[r];
+        }
+    }
+    return wynik;
+}
+
+/**
+ * @brief Iloczyn logiczny (OR z AND) metodą czterech Rosjan
+ * @details Dla każdej grupy GRUPA wierszy B budowana jest tablica OR-ów
+ * wszystkich ich podzbiorów; wiersz wyniku zbiera wpisy wskazane przez
+ * kolejne bajty wiersza A. Pasy słów kolumn liczone są w puli wątków.
+ * @param a Lewy czynnik
+ * @param b Prawy czynnik
+ * @return Macierz C, w której C(i, j) = OR_k (A(i, k) AND B(k, j))
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+macierz_bitowa operator*(const macierz_bitowa& a, const macierz_bitowa& b) {
+    sprawdz_rozmiary(a.n, b.n);
+    int n = a.n;
+    macierz_bitowa wynik(n);
+    int pasy = (a.slowa + SLOWA_PASA - 1) / SLOWA_PASA;
+
+    rozdziel(n, pasy, [&](int pas) {
+        int s0 = pas * SLOWA_PASA;
+        int szerokosc = std::min(SLOWA_PASA, a.slowa - s0);
+        std::uint64_t tablica[(1 << GRUPA) * SLOWA_PASA];
+        for (int k0 = 0; k0 < n; k0 += GRUPA) {
+            // tablica[maska] = OR wierszy k0 + t z ustawionym bitem t maski
+            int w_grupie = std::min(GRUPA, n - k0);
+            std::fill(tablica, tablica + szerokosc, 0);
+            for (int maska = 1; maska < (1 << w_grupie); ++maska) {
+                int t = std::countr_zero(static_cast<unsigned>(maska));
+                const std::uint64_t* poprzednia = tablica + (maska & (maska - 1)) * szerokosc;
+                const std::uint64_t* wiersz_b = b.wiersz(k0 + t) + s0;
+                std::uint64_t* cel = tablica + maska * szerokosc;
+                for (int w = 0; w < szerokosc; ++w) cel[w] = poprzednia[w] | wiersz_b[w];
+            }
+            int slowo_a = k0 / 64, przesuniecie = k0 % 64;
+            for (int i = 0; i < n; ++i) {
+                unsigned maska = static_cast<unsigned>(a.wiersz(i)[slowo_a] >> przesuniecie) & ((1u << GRUPA) - 1);
+                if (maska == 0) continue;
+                const std::uint64_t* z = tablica + maska * szerokosc;
+                std::uint64_t* c = wynik.wiersz(i) + s0;
+                for (int w = 0; w < szerokosc; ++w) c[w] |= z[w];
+            }
+        }
+    });
+    return wynik;
+}
+
+/**
+ * @brief Iloczyn zliczający: liczba ścieżek długości 2 zamiast ich istnienia
+ * @details Element (i, j) to popcount iloczynu AND wiersza i macierzy A
+ * i wiersza j macierzy B^T, liczony kaflami w puli wątków.
+ * @param a Lewy czynnik
+ * @param b Prawy czynnik
+ * @return Macierz liczb C, w której C(i, j) = suma_k A(i, k) * B(k, j)
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+matrix iloczyn_zliczajacy(const macierz_bitowa& a, const macierz_bitowa& b) {
+    sprawdz_rozmiary(a.n, b.n);
+    int n = a.n;
+    macierz_bitowa bt = b.odwrocona();
+    matrix wynik(n);
+    int pasy = (n + WIERSZE_PASA - 1) / WIERSZE_PASA;
+
+    rozdziel(n, pasy, [&](int pas) {
+        int r0 = pas * WIERSZE_PASA, r1 = std::min(n, r0 + WIERSZE_PASA);
+        // Kafle kolumn po WIERSZE_PASA wierszy B^T, używane przez cały pas wierszy A
+        for (int j0 = 0; j0 < n; j0 += WIERSZE_PASA) {
+            int j1 = std::min(n, j0 + WIERSZE_PASA);
+            for (int i = r0; i < r1; ++i) {
+                std::span<int> c = wynik.wiersz_do_zapisu(i);
+                const std::uint64_t* wa = a.wiersz(i);
+                for (int j = j0; j < j1; ++j) c[j] = wspolne_jedynki(wa, bt.wiersz(j), a.slowa);
+            }
+        }
+    });
+    return wynik;
+}
+
+/**
+ * @brief Wypisuje macierz jako zera i jedynki, w formacie klasy matrix
+ * @param o Strumień wyjściowy
+ * @param m Macierz do wypisania
+ * @return Referencja do strumienia
+ */
+std::ostream& operator<<(std::ostream& o, const macierz_bitowa& m) {
+    for (int i = 0; i < m.n; ++i) {
+        for (int j = 0; j < m.n; ++j) o << m.pokaz(i, j) << " ";
+        o << "\n";
+    }
+    return o;
+}
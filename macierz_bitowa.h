@@ -0,0 +1,185 @@
+#ifndef MACIERZ_BITOWA_H
+#define MACIERZ_BITOWA_H
+
+#include "matrix.h"
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+/**
+ * @file macierz_bitowa.h
+ * @brief Macierz logiczna upakowana po 64 elementy w słowie
+ *
+ * Macierze 0/1 (np. z matrix::szachownica, przekatna, pod_przekatna,
+ * nad_przekatna albo macierze sąsiedztwa grafów) zajmują w tej postaci
+ * jeden bit na element zamiast 32. Działania element po elemencie (AND,
+ * OR, XOR) przetwarzają 64 elementy jedną instrukcją, iloczyn logiczny
+ * liczony jest metodą czterech Rosjan, a iloczyn zliczający (zwykły
+ * iloczyn macierzy 0/1) przez AND słów i popcount.
+ */
+
+/**
+ * @class macierz_bitowa
+ * @brief Kwadratowa macierz logiczna z wierszami upakowanymi w słowa 64-bitowe
+ */
+class macierz_bitowa {
+private:
+    int n;                           ///< Rozmiar macierzy (n×n)
+    int slowa;                       ///< Liczba słów na wiersz ((n + 63) / 64)
+    std::vector<std::uint64_t> bity; ///< Wiersze po slowa słów; kolumna j to bit j % 64 słowa j / 64; bity poza n są zerowe
+
+    /**
+     * @brief Zwraca wskaźnik na słowa wiersza i
+     */
+    std::uint64_t* wiersz(int i) { return bity.data() + static_cast<std::size_t>(i) * slowa; }
+
+    /**
+     * @brief Zwraca wskaźnik tylko do odczytu na słowa wiersza i
+     */
+    const std::uint64_t* wiersz(int i) const { return bity.data() + static_cast<std::size_t>(i) * slowa; }
+
+public:
+    // ==================== Konstruktory ====================
+
+    /**
+     * @brief Konstruktor domyślny - pusta macierz 0×0
+     */
+    macierz_bitowa(void);
+
+    /**
+     * @brief Konstruktor tworzący zerową macierz n×n
+     * @param n Rozmiar macierzy
+     * @throw std::logic_error Jeśli n < 0
+     */
+    explicit macierz_bitowa(int n);
+
+    /**
+     * @brief Konstruktor upakowujący macierz gęstą (elementy niezerowe dają 1)
+     * @param m Macierz gęsta
+     */
+    explicit macierz_bitowa(const matrix& m);
+
+    /**
+     * @brief Rozpakowuje macierz do postaci gęstej z elementami 0 i 1
+     * @return Macierz gęsta n×n
+     */
+    matrix na_macierz(void) const;
+
+    /**
+     * @brief Tworzy macierz jednostkową n×n
+     * @param n Rozmiar macierzy
+     * @return Macierz z jedynkami na głównej przekątnej
+     */
+    static macierz_bitowa jednostkowa(int n);
+
+    // ==================== Dostęp ====================
+
+    /**
+     * @brief Zwraca wartość elementu
+     * @param x Indeks wiersza
+     * @param y Indeks kolumny
+     * @return true dla elementu równego 1
+     * @throw std::logic_error Jeśli współrzędne są poza zakresem
+     */
+    bool pokaz(int x, int y) const;
+
+    /**
+     * @brief Ustawia wartość elementu
+     * @param x Indeks wiersza
+     * @param y Indeks kolumny
+     * @param wartosc Nowa wartość
+     * @return Referencja do bieżącej macierzy
+     * @throw std::logic_error Jeśli współrzędne są poza zakresem
+     */
+    macierz_bitowa& wstaw(int x, int y, bool wartosc);
+
+    /**
+     * @brief Zwraca rozmiar macierzy
+     * @return Rozmiar n
+     */
+    int getSize() const { return n; }
+
+    /**
+     * @brief Zwraca liczbę jedynek w macierzy
+     */
+    std::size_t niezerowe() const;
+
+    // ==================== Działania element po elemencie ====================
+
+    /**
+     * @brief Iloczyn logiczny element po elemencie w miejscu
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    macierz_bitowa& operator&=(const macierz_bitowa& m);
+
+    /**
+     * @brief Suma logiczna element po elemencie w miejscu
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    macierz_bitowa& operator|=(const macierz_bitowa& m);
+
+    /**
+     * @brief Różnica symetryczna element po elemencie w miejscu
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    macierz_bitowa& operator^=(const macierz_bitowa& m);
+
+    /**
+     * @brief Iloczyn logiczny element po elemencie
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    friend macierz_bitowa operator&(macierz_bitowa a, const macierz_bitowa& b) { return a &= b; }
+
+    /**
+     * @brief Suma logiczna element po elemencie
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    friend macierz_bitowa operator|(macierz_bitowa a, const macierz_bitowa& b) { return a |= b; }
+
+    /**
+     * @brief Różnica symetryczna element po elemencie
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    friend macierz_bitowa operator^(macierz_bitowa a, const macierz_bitowa& b) { return a ^= b; }
+
+    /**
+     * @brief Sprawdza, czy macierze mają ten sam rozmiar i te same elementy
+     */
+    bool operator==(const macierz_bitowa& m) const { return n == m.n && bity == m.bity; }
+
+    // ==================== Iloczyny ====================
+
+    /**
+     * @brief Zwraca transpozycję macierzy
+     * @details Transpozycja liczona jest blokami 64×64 bity w rejestrach.
+     * @return Nowa macierz A^T
+     */
+    macierz_bitowa odwrocona(void) const;
+
+    /**
+     * @brief Iloczyn logiczny macierzy: C(i, j) = OR_k (A(i, k) AND B(k, j))
+     * @details Metoda czterech Rosjan: dla każdej grupy 8 wierszy B tablicowane
+     * są wszystkie 256 ich sum logicznych, a wiersz wyniku dostaje sumę
+     * wybraną bajtem wiersza A. Kolumny wyniku liczone są pasami w puli wątków.
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    friend macierz_bitowa operator*(const macierz_bitowa& a, const macierz_bitowa& b);
+
+    /**
+     * @brief Iloczyn zliczający: C(i, j) = liczba k, dla których A(i, k) = B(k, j) = 1
+     * @details Równy zwykłemu iloczynowi macierzy 0/1 (np. liczbie ścieżek
+     * długości 2); liczony jako popcount(wiersz A AND kolumna B) po słowach.
+     * @param a Pierwsza macierz
+     * @param b Druga macierz
+     * @return Macierz gęsta z liczbami wspólnych jedynek
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    friend matrix iloczyn_zliczajacy(const macierz_bitowa& a, const macierz_bitowa& b);
+
+    /**
+     * @brief Wypisuje macierz w postaci gęstej (format jak dla klasy matrix)
+     */
+    friend std::ostream& operator<<(std::ostream& o, const macierz_bitowa& m);
+};
+
+#endif
@@ -0,0 +1,254 @@
+/**
+ * @file macierz_pasmowa.cpp
+ * @brief Implementacja macierzy pasmowej w formacie DIA
+ */
+
+#include "macierz_pasmowa.h"
+#include <algorithm>
+#include <cstdlib>
+#include <ostream>
+#include <stdexcept>
+
+namespace {
+
+    /// Pierwszy wiersz, w którym przekątna k leży w macierzy n×n
+    inline int pierwszy_wiersz(int k) { return k < 0 ? -k : 0; }
+
+    /// Wiersz za ostatnim, w którym przekątna k leży w macierzy n×n
+    inline int koniec_wiersza(int n, int k) { return k > 0 ? n - k : n; }
+
+    /**
+     * @brief Sprawdza zgodność rozmiarów argumentów działania
+     * @throw std::logic_error Jeśli rozmiary są różne
+     */
+    void sprawdz_rozmiary(int n1, int n2) {
+        if (n1 != n2) throw std::logic_error("Macierze muszą mieć ten sam rozmiar");
+    }
+}
+
+// ==================== Konstruktory ====================
+
+/**
+ * @brief Konstruktor domyślny - tworzy pustą macierz o rozmiarze 0x0
+ */
+macierz_pasmowa::macierz_pasmowa(void) : n(0) {}
+
+/**
+ * @brief Konstruktor parametryczny - tworzy zerową macierz n×n (bez przekątnych)
+ * @param n Rozmiar macierzy kwadratowej
+ */
+macierz_pasmowa::macierz_pasmowa(int n) : n(n) {}
+
+/**
+ * @brief Konstruktor konwertujący macierz gęstą (zapamiętuje niezerowe przekątne)
+ * @param m Macierz źródłowa
+ */
+macierz_pasmowa::macierz_pasmowa(const matrix& m) : n(m.getSize()) {
+    for (int k = -n + 1; k < n; ++k) {
+        bool niezerowa = false;
+        for (int i = pierwszy_wiersz(k); i < koniec_wiersza(n, k) && !niezerowa; ++i)
+            niezerowa = m.pokaz(i, i + k) != 0;
+        if (!niezerowa) continue;
+        int* d = przekatna(k);
+        for (int i = pierwszy_wiersz(k); i < koniec_wiersza(n, k); ++i) d[i] = m.pokaz(i, i + k);
+    }
+}
+
+/**
+ * @brief Tworzy macierz gęstą o tych samych elementach
+ * @return Nowa macierz n×n
+ */
+matrix macierz_pasmowa::na_macierz(void) const {
+    matrix wynik(n);
+    for (std::size_t d = 0; d < przesuniecia.size(); ++d) {
+        int k = przesuniecia[d];
+        const int* p = dane.data() + d * n;
+        for (int i = pierwszy_wiersz(k); i < koniec_wiersza(n, k); ++i) wynik.wstaw(i, i + k, p[i]);
+    }
+    return wynik;
+}
+
+// ==================== Przekątne ====================
+
+/**
+ * @brief Zwraca dane przekątnej k, dodając ją (wyzerowaną), jeśli jej nie było
+ * @param k Numer przekątnej
+ * @return Wskaźnik na n elementów; element wiersza i ma indeks i
+ */
+int* macierz_pasmowa::przekatna(int k) {
+    auto it = std::lower_bound(przesuniecia.begin(), przesuniecia.end(), k);
+    std::size_t d = it - przesuniecia.begin();
+    if (it == przesuniecia.end() || *it != k) {
+        przesuniecia.insert(it, k);
+        dane.insert(dane.begin() + d * n, n, 0);
+    }
+    return dane.data() + d * n;
+}
+
+/**
+ * @brief Zwraca dane przekątnej k bez jej dodawania
+ * @param k Numer przekątnej
+ * @return Wskaźnik na n elementów albo nullptr, jeśli przekątnej nie ma
+ */
+const int* macierz_pasmowa::przekatna(int k) const {
+    auto it = std::lower_bound(przesuniecia.begin(), przesuniecia.end(), k);
+    if (it == przesuniecia.end() || *it != k) return nullptr;
+    return dane.data() + (it - przesuniecia.begin()) * n;
+}
+
+/**
+ * @brief Ustawia wartości głównej przekątnej
+ * @param t Tablica n wartości
+ * @return Referencja do bieżącej macierzy
+ */
+macierz_pasmowa& macierz_pasmowa::diagonalna(int* t) {
+    return diagonalna_k(0, t);
+}
+
+/**
+ * @brief Ustawia wartości k-tej przekątnej
+ * @param k Numer przekątnej (0 - główna, > 0 - nad, < 0 - pod)
+ * @param t Tablica n - |k| wartości
+ * @return Referencja do bieżącej macierzy
+ * @throw std::logic_error Jeśli |k| >= n
+ */
+macierz_pasmowa& macierz_pasmowa::diagonalna_k(int k, int* t) {
+    if (abs(k) >= n) throw std::logic_error("Zle wspolrzedne macierzy");
+    int* d = przekatna(k);
+    int pierwszy = pierwszy_wiersz(k);
+    std::copy(t, t + (n - abs(k)), d + pierwszy);
+    return *this;
+}
+
+// ==================== Dostęp ====================
+
+/**
+ * @brief Zwraca wartość elementu
+ * @param x Indeks wiersza
+ * @param y Indeks kolumny
+ * @return Wartość elementu (0 poza zapamiętanymi przekątnymi)
+ * @throw std::logic_error Jeśli współrzędne są poza zakresem
+ */
+int macierz_pasmowa::pokaz(int x, int y) const {
+    if (x >= n || y >= n || x < 0 || y < 0)
+        throw std::logic_error("Zle wspolrzedne macierzy");
+    const int* d = przekatna(y - x);
+    return d ? d[x] : 0;
+}
+
+/**
+ * @brief Zwraca szerokość pasma
+ * @return Największe |k| zapamiętanej przekątnej (0 dla macierzy bez przekątnych)
+ */
+int macierz_pasmowa::szerokosc_pasma() const {
+    if (przesuniecia.empty()) return 0;
+    return std::max(abs(przesuniecia.front()), abs(przesuniecia.back()));
+}
+
+// ==================== Działania ====================
+
+/**
+ * @brief Zwraca transpozycję macierzy
+ * @details Element (i, i+k) przechodzi na (i+k, i), czyli na przekątną -k
+ * w wierszu i+k.
+ * @return Nowa macierz A^T
+ */
+macierz_pasmowa macierz_pasmowa::odwrocona(void) const {
+    macierz_pasmowa wynik(n);
+    wynik.przesuniecia.resize(przesuniecia.size());
+    wynik.dane.assign(dane.size(), 0);
+    std::size_t ile = przesuniecia.size();
+    for (std::size_t d = 0; d < ile; ++d) {
+        int k = przesuniecia[d];
+        std::size_t cel = ile - 1 - d;
+        wynik.przesuniecia[cel] = -k;
+        const int* zrodlo = dane.data() + d * n;
+        int* p = wynik.dane.data() + cel * n;
+        for (int i = pierwszy_wiersz(k); i < koniec_wiersza(n, k); ++i) p[i + k] = zrodlo[i];
+    }
+    return wynik;
+}
+
+/**
+ * @brief Sprawdza, czy macierze mają te same elementy
+ * @details Brakująca przekątna jest równa przekątnej z samych zer.
+ * @param m Macierz do porównania
+ * @return true, jeśli macierze są równe
+ */
+bool macierz_pasmowa::operator==(const macierz_pasmowa& m) const {
+    if (n != m.n) return false;
+    for (int k = -n + 1; k < n; ++k) {
+        const int* a = przekatna(k);
+        const int* b = m.przekatna(k);
+        if (!a && !b) continue;
+        for (int i = pierwszy_wiersz(k); i < koniec_wiersza(n, k); ++i) {
+            if ((a ? a[i] : 0) != (b ? b[i] : 0)) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Dodaje dwie macierze pasmowe przekątna po przekątnej (modulo 2^32)
+ * @param a Pierwsza macierz
+ * @param b Druga macierz
+ * @return Suma A + B
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+macierz_pasmowa operator+(const macierz_pasmowa& a, const macierz_pasmowa& b) {
+    sprawdz_rozmiary(a.n, b.n);
+    int n = a.n;
+    macierz_pasmowa wynik(a);
+    for (std::size_t d = 0; d < b.przesuniecia.size(); ++d) {
+        int k = b.przesuniecia[d];
+        int* p = wynik.przekatna(k);
+        const int* q = b.dane.data() + d * n;
+        for (int i = pierwszy_wiersz(k); i < koniec_wiersza(n, k); ++i)
+            p[i] = static_cast<int>(static_cast<unsigned>(p[i]) + static_cast<unsigned>(q[i]));
+    }
+    return wynik;
+}
+
+/**
+ * @brief Mnoży dwie macierze pasmowe (przekątne ka i kb dają przekątną ka + kb)
+ * @param a Lewy czynnik
+ * @param b Prawy czynnik
+ * @return Iloczyn A * B (modulo 2^32)
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+macierz_pasmowa operator*(const macierz_pasmowa& a, const macierz_pasmowa& b) {
+    sprawdz_rozmiary(a.n, b.n);
+    int n = a.n;
+    macierz_pasmowa wynik(n);
+    for (std::size_t da = 0; da < a.przesuniecia.size(); ++da) {
+        int ka = a.przesuniecia[da];
+        const int* pa = a.dane.data() + da * n;
+        for (std::size_t db = 0; db < b.przesuniecia.size(); ++db) {
+            int kb = b.przesuniecia[db];
+            int k = ka + kb;
+            if (abs(k) >= n) continue;
+            const int* pb = b.dane.data() + db * n;
+            int* pc = wynik.przekatna(k);
+            // Wiersz i musi leżeć na przekątnej ka w A, a wiersz i+ka na przekątnej kb w B
+            int od = std::max(pierwszy_wiersz(ka), pierwszy_wiersz(kb) - ka);
+            int do_ = std::min(koniec_wiersza(n, ka), koniec_wiersza(n, kb) - ka);
+            for (int i = od; i < do_; ++i)
+                pc[i] = static_cast<int>(static_cast<unsigned>(pc[i]) + static_cast<unsigned>(pa[i]) * static_cast<unsigned>(pb[i + ka]));
+        }
+    }
+    return wynik;
+}
+
+/**
+ * @brief Wypisuje macierz w postaci gęstej, w formacie klasy matrix
+ * @param o Strumień wyjściowy
+ * @param m Macierz do wypisania
+ * @return Referencja do strumienia
+ */
+std::ostream& operator<<(std::ostream& o, const macierz_pasmowa& m) {
+    for (int i = 0; i < m.n; ++i) {
+        for (int j = 0; j < m.n; ++j) o << m.pokaz(i, j) << " ";
+        o << "\n";
+    }
+    return o;
+}
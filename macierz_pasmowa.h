@@ -0,0 +1,149 @@
+#ifndef MACIERZ_PASMOWA_H
+#define MACIERZ_PASMOWA_H
+
+#include "matrix.h"
+#include <iosfwd>
+#include <vector>
+
+/**
+ * @file macierz_pasmowa.h
+ * @brief Macierz pasmowa przechowująca tylko wypełnione przekątne (format DIA)
+ *
+ * Macierz jest zbiorem przekątnych o numerach k (0 - główna, >0 - nad,
+ * <0 - pod), tak jak w matrix::diagonalna_k. Każda zapisana przekątna zajmuje
+ * n elementów indeksowanych numerem wiersza, więc macierz trójdiagonalna
+ * n = 10^5 mieści się w 1,2 MB. Dodawanie, mnożenie i transpozycja kosztują
+ * O(n · liczba przekątnych). Arytmetyka jest modulo 2^32.
+ */
+
+/**
+ * @class macierz_pasmowa
+ * @brief Kwadratowa macierz pasmowa liczb całkowitych (DIA)
+ */
+class macierz_pasmowa {
+private:
+    int n;                           ///< Rozmiar macierzy (n×n)
+    std::vector<int> przesuniecia;   ///< Numery zapisanych przekątnych (rosnąco)
+    std::vector<int> dane;           ///< Przekątne po n elementów; element (i, i+k) pod indeksem i
+
+    /**
+     * @brief Zwraca dane k-tej przekątnej, dodając ją (wyzerowaną) jeśli nie istnieje
+     * @param k Numer przekątnej
+     * @return Wskaźnik na n elementów przekątnej
+     */
+    int* przekatna(int k);
+
+    /**
+     * @brief Zwraca dane k-tej przekątnej lub nullptr, jeśli nie jest zapisana
+     * @param k Numer przekątnej
+     */
+    const int* przekatna(int k) const;
+
+public:
+    // ==================== Konstruktory ====================
+
+    /**
+     * @brief Konstruktor domyślny - pusta macierz 0×0
+     */
+    macierz_pasmowa(void);
+
+    /**
+     * @brief Konstruktor tworzący zerową macierz n×n (bez zapisanych przekątnych)
+     * @param n Rozmiar macierzy
+     */
+    explicit macierz_pasmowa(int n);
+
+    /**
+     * @brief Konstruktor zapisujący niezerowe przekątne macierzy gęstej
+     * @param m Macierz gęsta
+     */
+    explicit macierz_pasmowa(const matrix& m);
+
+    /**
+     * @brief Rozpakowuje macierz do postaci gęstej
+     * @return Macierz gęsta n×n
+     */
+    matrix na_macierz(void) const;
+
+    // ==================== Przekątne ====================
+
+    /**
+     * @brief Ustawia wartości na głównej przekątnej macierzy
+     * @param t Tablica z wartościami (wymaga n elementów)
+     * @return Referencja do bieżącej macierzy
+     */
+    macierz_pasmowa& diagonalna(int* t);
+
+    /**
+     * @brief Ustawia wartości na k-tej przekątnej (tak jak matrix::diagonalna_k)
+     * @param k Numer przekątnej (0 - główna, >0 - nad, <0 - pod)
+     * @param t Tablica z wartościami (wymaga n - |k| elementów)
+     * @return Referencja do bieżącej macierzy
+     * @throw std::logic_error Jeśli |k| >= n
+     */
+    macierz_pasmowa& diagonalna_k(int k, int* t);
+
+    // ==================== Dostęp ====================
+
+    /**
+     * @brief Zwraca wartość elementu
+     * @param x Indeks wiersza
+     * @param y Indeks kolumny
+     * @return Wartość elementu (0 poza zapisanymi przekątnymi)
+     * @throw std::logic_error Jeśli współrzędne są poza zakresem
+     */
+    int pokaz(int x, int y) const;
+
+    /**
+     * @brief Zwraca rozmiar macierzy
+     * @return Rozmiar n
+     */
+    int getSize() const { return n; }
+
+    /**
+     * @brief Zwraca liczbę zapisanych przekątnych
+     */
+    int liczba_przekatnych() const { return static_cast<int>(przesuniecia.size()); }
+
+    /**
+     * @brief Zwraca szerokość pasma (największe |k| wśród zapisanych przekątnych)
+     */
+    int szerokosc_pasma() const;
+
+    // ==================== Działania ====================
+
+    /**
+     * @brief Zwraca transpozycję macierzy (przekątna k przechodzi na -k)
+     * @return Nowa macierz A^T
+     */
+    macierz_pasmowa odwrocona(void) const;
+
+    /**
+     * @brief Sprawdza, czy macierze mają ten sam rozmiar i te same elementy
+     * @details Przekątne zapisane w jednej macierzy, a brakujące w drugiej,
+     * muszą być zerowe.
+     */
+    bool operator==(const macierz_pasmowa& m) const;
+
+    /**
+     * @brief Dodaje dwie macierze pasmowe (suma zbiorów przekątnych)
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    friend macierz_pasmowa operator+(const macierz_pasmowa& a, const macierz_pasmowa& b);
+
+    /**
+     * @brief Mnoży dwie macierze pasmowe
+     * @details Przekątna ka macierzy A razy przekątna kb macierzy B daje
+     * przyczynek do przekątnej ka + kb wyniku:
+     * C(i, i+ka+kb) += A(i, i+ka) * B(i+ka, i+ka+kb)
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    friend macierz_pasmowa operator*(const macierz_pasmowa& a, const macierz_pasmowa& b);
+
+    /**
+     * @brief Wypisuje macierz w postaci gęstej (format jak dla klasy matrix)
+     */
+    friend std::ostream& operator<<(std::ostream& o, const macierz_pasmowa& m);
+};
+
+#endif
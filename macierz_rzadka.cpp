@@ -0,0 +1,313 @@
+/**
+ * @file macierz_rzadka.cpp
+ * @brief Implementacja macierzy rzadkiej w formacie CSR
+ */
+
+#include "macierz_rzadka.h"
+#include <algorithm>
+#include <cstdlib>
+#include <ostream>
+#include <stdexcept>
+
+namespace {
+
+    /// a + b modulo 2^32
+    inline int dodaj(int a, int b) {
+        return static_cast<int>(static_cast<unsigned>(a) + static_cast<unsigned>(b));
+    }
+
+    /// a + b * c modulo 2^32
+    inline int dodaj_iloczyn(int a, int b, int c) {
+        return static_cast<int>(static_cast<unsigned>(a) + static_cast<unsigned>(b) * static_cast<unsigned>(c));
+    }
+
+    /**
+     * @brief Sprawdza zgodność rozmiarów argumentów działania
+     * @throw std::logic_error Jeśli rozmiary są różne
+     */
+    void sprawdz_rozmiary(int n1, int n2) {
+        if (n1 != n2) throw std::logic_error("Macierze muszą mieć ten sam rozmiar");
+    }
+}
+
+// ==================== Konstruktory ====================
+
+/**
+ * @brief Konstruktor domyślny - tworzy pustą macierz o rozmiarze 0x0
+ */
+macierz_rzadka::macierz_rzadka(void) : n(0), wiersze(1, 0) {}
+
+/**
+ * @brief Konstruktor parametryczny - tworzy zerową macierz n×n (bez elementów)
+ * @param n Rozmiar macierzy kwadratowej
+ */
+macierz_rzadka::macierz_rzadka(int n) : n(n), wiersze(static_cast<std::size_t>(n) + 1, 0) {}
+
+/**
+ * @brief Konstruktor z listy elementów (wiersz, kolumna, wartość)
+ * @details Elementy są sortowane po (wiersz, kolumna), a następnie
+ * scalane w jednym przebiegu. Powtórzone współrzędne są sumowane,
+ * a zerowe sumy pomijane.
+ * @param n Rozmiar macierzy
+ * @param elementy Elementy niezerowe w dowolnej kolejności
+ * @throw std::logic_error Jeśli któryś element leży poza macierzą
+ */
+macierz_rzadka::macierz_rzadka(int n, const std::vector<element>& elementy) : macierz_rzadka(n) {
+    for (const element& e : elementy) {
+        if (e.wiersz >= n || e.kolumna >= n || e.wiersz < 0 || e.kolumna < 0)
+            throw std::logic_error("Zle wspolrzedne macierzy");
+    }
+    std::vector<element> posortowane(elementy);
+    std::sort(posortowane.begin(), posortowane.end(), [](const element& a, const element& b) {
+        return a.wiersz != b.wiersz ? a.wiersz < b.wiersz : a.kolumna < b.kolumna;
+    });
+
+    std::size_t i = 0;
+    while (i < posortowane.size()) {
+        const element& e = posortowane[i];
+        int suma = 0;
+        for (; i < posortowane.size() && posortowane[i].wiersz == e.wiersz && posortowane[i].kolumna == e.kolumna; ++i)
+            suma = dodaj(suma, posortowane[i].wartosc);
+        if (suma == 0) continue;
+        kolumny.push_back(e.kolumna);
+        wartosci.push_back(suma);
+        ++wiersze[e.wiersz + 1];
+    }
+    for (int r = 0; r < n; ++r) wiersze[r + 1] += wiersze[r];
+}
+
+/**
+ * @brief Konstruktor konwertujący macierz gęstą (zapamiętuje jej niezerowe elementy)
+ * @param m Macierz źródłowa
+ */
+macierz_rzadka::macierz_rzadka(const matrix& m) : macierz_rzadka(m.n) {
+    const int* dane = m.macierz_ptr.get();
+    for (int i = 0; i < n; ++i) {
+        const int* wiersz = dane + static_cast<std::size_t>(i) * n;
+        for (int j = 0; j < n; ++j) {
+            if (wiersz[j] != 0) {
+                kolumny.push_back(j);
+                wartosci.push_back(wiersz[j]);
+            }
+        }
+        wiersze[i + 1] = static_cast<int>(wartosci.size());
+    }
+}
+
+/**
+ * @brief Tworzy macierz jednostkową n×n
+ * @param n Rozmiar macierzy
+ * @return Macierz z jedynkami na głównej przekątnej
+ */
+macierz_rzadka macierz_rzadka::przekatna(int n) {
+    macierz_rzadka wynik(n);
+    wynik.kolumny.resize(n);
+    wynik.wartosci.assign(n, 1);
+    for (int i = 0; i < n; ++i) {
+        wynik.kolumny[i] = i;
+        wynik.wiersze[i + 1] = i + 1;
+    }
+    return wynik;
+}
+
+/**
+ * @brief Tworzy macierz z danymi na k-tej przekątnej (jak matrix::diagonalna_k)
+ * @param n Rozmiar macierzy
+ * @param k Numer przekątnej (0 - główna, > 0 - nad, < 0 - pod)
+ * @param t Tablica wartości przekątnej (n - |k| elementów); zera są pomijane
+ * @return Nowa macierz rzadka
+ */
+macierz_rzadka macierz_rzadka::diagonalna_k(int n, int k, const int* t) {
+    macierz_rzadka wynik(n);
+    int offset = abs(k);
+    for (int r = 0; r < n; ++r) {
+        int i = (k >= 0) ? r : (r - offset);
+        int col = r + k;
+        if (col >= 0 && col < n && t[i] != 0) {
+            wynik.kolumny.push_back(col);
+            wynik.wartosci.push_back(t[i]);
+        }
+        wynik.wiersze[r + 1] = static_cast<int>(wynik.wartosci.size());
+    }
+    return wynik;
+}
+
+/**
+ * @brief Tworzy macierz gęstą o tych samych elementach
+ * @return Nowa macierz n×n
+ */
+matrix macierz_rzadka::na_macierz(void) const {
+    matrix wynik(n);
+    int* dane = wynik.macierz_ptr.get();
+    for (int i = 0; i < n; ++i) {
+        for (int p = wiersze[i]; p < wiersze[i + 1]; ++p)
+            dane[static_cast<std::size_t>(i) * n + kolumny[p]] = wartosci[p];
+    }
+    return wynik;
+}
+
+// ==================== Dostęp ====================
+
+/**
+ * @brief Zwraca wartość elementu (wyszukiwanie binarne w wierszu)
+ * @param x Indeks wiersza
+ * @param y Indeks kolumny
+ * @return Wartość elementu (0, jeśli nie jest zapamiętany)
+ * @throw std::logic_error Jeśli współrzędne są poza zakresem
+ */
+int macierz_rzadka::pokaz(int x, int y) const {
+    if (x >= n || y >= n || x < 0 || y < 0)
+        throw std::logic_error("Zle wspolrzedne macierzy");
+    auto poczatek = kolumny.begin() + wiersze[x];
+    auto koniec = kolumny.begin() + wiersze[x + 1];
+    auto it = std::lower_bound(poczatek, koniec, y);
+    if (it == koniec || *it != y) return 0;
+    return wartosci[it - kolumny.begin()];
+}
+
+/**
+ * @brief Zwraca transpozycję macierzy
+ * @details Zliczanie elementów w kolumnach, sumy prefiksowe i rozłożenie
+ * elementów; kolejne wiersze źródła dają rosnące kolumny wyniku.
+ * @return Nowa macierz A^T
+ */
+macierz_rzadka macierz_rzadka::odwrocona(void) const {
+    macierz_rzadka wynik(n);
+    wynik.kolumny.resize(kolumny.size());
+    wynik.wartosci.resize(wartosci.size());
+    for (int c : kolumny) ++wynik.wiersze[c + 1];
+    for (int r = 0; r < n; ++r) wynik.wiersze[r + 1] += wynik.wiersze[r];
+
+    std::vector<int> pozycja(wynik.wiersze.begin(), wynik.wiersze.end() - 1);
+    for (int i = 0; i < n; ++i) {
+        for (int p = wiersze[i]; p < wiersze[i + 1]; ++p) {
+            int cel = pozycja[kolumny[p]]++;
+            wynik.kolumny[cel] = i;
+            wynik.wartosci[cel] = wartosci[p];
+        }
+    }
+    return wynik;
+}
+
+/**
+ * @brief Sprawdza, czy macierze mają ten sam rozmiar i te same elementy
+ * @param m Macierz do porównania
+ * @return true, jeśli macierze są równe
+ */
+bool macierz_rzadka::operator==(const macierz_rzadka& m) const {
+    return n == m.n && wiersze == m.wiersze && kolumny == m.kolumny && wartosci == m.wartosci;
+}
+
+// ==================== Mnożenie ====================
+
+/**
+ * @brief Mnoży macierz rzadką przez gęstą (wiersze B skalowane elementami A)
+ * @param a Macierz rzadka
+ * @param b Macierz gęsta
+ * @return Iloczyn A * B jako macierz gęsta
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+matrix operator*(const macierz_rzadka& a, const matrix& b) {
+    sprawdz_rozmiary(a.n, b.n);
+    int n = a.n;
+    matrix wynik(n);
+    const int* db = b.macierz_ptr.get();
+    int* dc = wynik.macierz_ptr.get();
+    for (int i = 0; i < n; ++i) {
+        int* wiersz_c = dc + static_cast<std::size_t>(i) * n;
+        for (int p = a.wiersze[i]; p < a.wiersze[i + 1]; ++p) {
+            int v = a.wartosci[p];
+            const int* wiersz_b = db + static_cast<std::size_t>(a.kolumny[p]) * n;
+            for (int j = 0; j < n; ++j) wiersz_c[j] = dodaj_iloczyn(wiersz_c[j], v, wiersz_b[j]);
+        }
+    }
+    return wynik;
+}
+
+/**
+ * @brief Mnoży macierz gęstą przez rzadką (rozrzucanie elementów wierszy B)
+ * @param a Macierz gęsta
+ * @param b Macierz rzadka
+ * @return Iloczyn A * B jako macierz gęsta
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+matrix operator*(const matrix& a, const macierz_rzadka& b) {
+    sprawdz_rozmiary(a.n, b.n);
+    int n = a.n;
+    matrix wynik(n);
+    const int* da = a.macierz_ptr.get();
+    int* dc = wynik.macierz_ptr.get();
+    for (int i = 0; i < n; ++i) {
+        const int* wiersz_a = da + static_cast<std::size_t>(i) * n;
+        int* wiersz_c = dc + static_cast<std::size_t>(i) * n;
+        for (int k = 0; k < n; ++k) {
+            int v = wiersz_a[k];
+            if (v == 0) continue;
+            for (int p = b.wiersze[k]; p < b.wiersze[k + 1]; ++p)
+                wiersz_c[b.kolumny[p]] = dodaj_iloczyn(wiersz_c[b.kolumny[p]], v, b.wartosci[p]);
+        }
+    }
+    return wynik;
+}
+
+/**
+ * @brief Mnoży dwie macierze rzadkie (algorytm Gustavsona z gęstym akumulatorem wiersza)
+ * @param a Lewy czynnik
+ * @param b Prawy czynnik
+ * @return Iloczyn A * B jako macierz rzadka (bez zerowych elementów)
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+macierz_rzadka operator*(const macierz_rzadka& a, const macierz_rzadka& b) {
+    sprawdz_rozmiary(a.n, b.n);
+    int n = a.n;
+    macierz_rzadka wynik(n);
+    std::vector<int> akumulator(n, 0);
+    std::vector<char> zajeta(n, 0);
+    std::vector<int> zajete;
+
+    for (int i = 0; i < n; ++i) {
+        for (int p = a.wiersze[i]; p < a.wiersze[i + 1]; ++p) {
+            int v = a.wartosci[p];
+            int k = a.kolumny[p];
+            for (int q = b.wiersze[k]; q < b.wiersze[k + 1]; ++q) {
+                int j = b.kolumny[q];
+                if (!zajeta[j]) {
+                    zajeta[j] = 1;
+                    zajete.push_back(j);
+                }
+                akumulator[j] = dodaj_iloczyn(akumulator[j], v, b.wartosci[q]);
+            }
+        }
+        std::sort(zajete.begin(), zajete.end());
+        for (int j : zajete) {
+            if (akumulator[j] != 0) {
+                wynik.kolumny.push_back(j);
+                wynik.wartosci.push_back(akumulator[j]);
+            }
+            akumulator[j] = 0;
+            zajeta[j] = 0;
+        }
+        zajete.clear();
+        wynik.wiersze[i + 1] = static_cast<int>(wynik.wartosci.size());
+    }
+    return wynik;
+}
+
+/**
+ * @brief Wypisuje macierz w postaci gęstej, w formacie klasy matrix
+ * @param o Strumień wyjściowy
+ * @param m Macierz do wypisania
+ * @return Referencja do strumienia
+ */
+std::ostream& operator<<(std::ostream& o, const macierz_rzadka& m) {
+    for (int i = 0; i < m.n; ++i) {
+        int p = m.wiersze[i];
+        for (int j = 0; j < m.n; ++j) {
+            int v = 0;
+            if (p < m.wiersze[i + 1] && m.kolumny[p] == j) v = m.wartosci[p++];
+            o << v << " ";
+        }
+        o << "\n";
+    }
+    return o;
+}
@@ -0,0 +1,158 @@
+#ifndef MACIERZ_RZADKA_H
+#define MACIERZ_RZADKA_H
+
+#include "matrix.h"
+#include <iosfwd>
+#include <vector>
+
+/**
+ * @file macierz_rzadka.h
+ * @brief Rzadka macierz kwadratowa w formacie CSR (Compressed Sparse Row)
+ *
+ * Przechowywane są wyłącznie niezerowe elementy: dla każdego wiersza
+ * zakres w tablicach kolumn i wartości, posortowany rosnąco po kolumnie.
+ * Pamięć i czas mnożenia są proporcjonalne do liczby niezerowych elementów,
+ * a nie do n*n. Arytmetyka, tak jak w klasie matrix, jest modulo 2^32.
+ */
+
+/**
+ * @class macierz_rzadka
+ * @brief Kwadratowa macierz rzadka liczb całkowitych (CSR)
+ */
+class macierz_rzadka {
+private:
+    int n;                       ///< Rozmiar macierzy (n×n)
+    std::vector<int> wiersze;    ///< Początki wierszy w kolumny/wartosci (n+1 elementów)
+    std::vector<int> kolumny;    ///< Indeksy kolumn niezerowych elementów
+    std::vector<int> wartosci;   ///< Wartości niezerowych elementów
+
+public:
+    /**
+     * @struct element
+     * @brief Pojedynczy element (wiersz, kolumna, wartość) do budowy macierzy
+     */
+    struct element {
+        int wiersz;  ///< Indeks wiersza
+        int kolumna; ///< Indeks kolumny
+        int wartosc; ///< Wartość
+    };
+
+    // ==================== Konstruktory ====================
+
+    /**
+     * @brief Konstruktor domyślny - pusta macierz 0×0
+     */
+    macierz_rzadka(void);
+
+    /**
+     * @brief Konstruktor tworzący zerową macierz n×n
+     * @param n Rozmiar macierzy
+     */
+    explicit macierz_rzadka(int n);
+
+    /**
+     * @brief Konstruktor z listy elementów
+     * @details Elementy mogą być w dowolnej kolejności; powtórzone pozycje
+     * są sumowane, a zerowe wyniki pomijane.
+     * @param n Rozmiar macierzy
+     * @param elementy Lista elementów
+     * @throw std::logic_error Jeśli któryś element leży poza macierzą
+     */
+    macierz_rzadka(int n, const std::vector<element>& elementy);
+
+    /**
+     * @brief Konstruktor kompresujący macierz gęstą (pomija zera)
+     * @param m Macierz gęsta
+     */
+    explicit macierz_rzadka(const matrix& m);
+
+    /**
+     * @brief Tworzy macierz jednostkową n×n (odpowiednik matrix::przekatna)
+     * @param n Rozmiar macierzy
+     * @return Macierz z jedynkami na głównej przekątnej
+     */
+    static macierz_rzadka przekatna(int n);
+
+    /**
+     * @brief Tworzy macierz z wartościami na k-tej przekątnej (odpowiednik matrix::diagonalna_k)
+     * @param n Rozmiar macierzy
+     * @param k Numer przekątnej (0 - główna, >0 - nad, <0 - pod)
+     * @param t Tablica z wartościami (wymaga n - |k| elementów)
+     * @return Macierz z niezerowymi elementami tylko na k-tej przekątnej
+     */
+    static macierz_rzadka diagonalna_k(int n, int k, const int* t);
+
+    /**
+     * @brief Rozpakowuje macierz do postaci gęstej
+     * @return Macierz gęsta n×n
+     */
+    matrix na_macierz(void) const;
+
+    // ==================== Dostęp ====================
+
+    /**
+     * @brief Zwraca wartość elementu (wyszukiwanie binarne w wierszu)
+     * @param x Indeks wiersza
+     * @param y Indeks kolumny
+     * @return Wartość elementu (0 dla elementów niezapisanych)
+     * @throw std::logic_error Jeśli współrzędne są poza zakresem
+     */
+    int pokaz(int x, int y) const;
+
+    /**
+     * @brief Zwraca rozmiar macierzy
+     * @return Rozmiar n
+     */
+    int getSize() const { return n; }
+
+    /**
+     * @brief Zwraca liczbę przechowywanych niezerowych elementów
+     * @return Liczba niezerowych elementów
+     */
+    std::size_t niezerowe() const { return wartosci.size(); }
+
+    /**
+     * @brief Zwraca transpozycję macierzy (CSR macierzy A^T, czyli CSC macierzy A)
+     * @return Nowa macierz A^T
+     */
+    macierz_rzadka odwrocona(void) const;
+
+    /**
+     * @brief Sprawdza, czy macierze mają ten sam rozmiar i te same elementy
+     * @param m Macierz do porównania
+     * @return true jeśli macierze są równe
+     */
+    bool operator==(const macierz_rzadka& m) const;
+
+    // ==================== Mnożenie ====================
+
+    /**
+     * @brief Mnoży macierz rzadką przez gęstą (C = A * B)
+     * @details Każdy niezerowy A(i, k) dodaje A(i, k) * B(k, :) do wiersza C(i, :)
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    friend matrix operator*(const macierz_rzadka& a, const matrix& b);
+
+    /**
+     * @brief Mnoży macierz gęstą przez rzadką (C = A * B)
+     * @details Każdy A(i, k) dodaje A(i, k) * B(k, :) do wiersza C(i, :),
+     * przechodząc tylko po niezerowych elementach wiersza k macierzy B
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    friend matrix operator*(const matrix& a, const macierz_rzadka& b);
+
+    /**
+     * @brief Mnoży dwie macierze rzadkie (algorytm Gustavsona)
+     * @details Wiersz wyniku zbierany jest w gęstym akumulatorze z listą
+     * zajętych kolumn, więc koszt zależy od liczby niezerowych iloczynów
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    friend macierz_rzadka operator*(const macierz_rzadka& a, const macierz_rzadka& b);
+
+    /**
+     * @brief Wypisuje macierz w postaci gęstej (format jak dla klasy matrix)
+     */
+    friend std::ostream& operator<<(std::ostream& o, const macierz_rzadka& m);
+};
+
+#endif
@@ -0,0 +1,314 @@
+#ifndef MACIERZ_STALA_H
+#define MACIERZ_STALA_H
+
+#include "matrix.h"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @file macierz_stala.h
+ * @brief Macierz kwadratowa o rozmiarze znanym w czasie kompilacji (2×2 do 8×8)
+ *
+ * Dane przechowywane są bezpośrednio w obiekcie (bez alokacji na stercie),
+ * a pętle operatorów rozwijane są w czasie kompilacji przez rozwinięcie
+ * paczek indeksów. Wszystkie działania są constexpr, a arytmetyka, tak jak
+ * w jądrach klasy matrix, jest modulo 2^32.
+ * @code
+ * macierz_stala<3> a{ { 1, 2, 3, 4, 5, 6, 7, 8, 9 } };
+ * macierz_stala<3> b = a * a + 1;
+ * matrix m = b.na_macierz();
+ * @endcode
+ */
+
+/**
+ * @class macierz_stala
+ * @brief Kwadratowa macierz N×N liczb całkowitych przechowywana w obiekcie
+ * @tparam N Rozmiar macierzy (od 2 do 8)
+ */
+template <int N>
+class macierz_stala {
+    static_assert(N >= 2 && N <= 8, "macierz_stala obsluguje rozmiary od 2 do 8");
+
+public:
+    static constexpr int ROZMIAR = N;          ///< Rozmiar macierzy
+    static constexpr int ELEMENTY = N * N;     ///< Liczba elementów
+
+private:
+    std::array<int, ELEMENTY> dane; ///< Dane macierzy (przechowywane wierszami)
+
+    using indeksy = std::make_integer_sequence<int, ELEMENTY>; ///< 0, 1, ..., N*N-1
+    using indeksy_k = std::make_integer_sequence<int, N>;      ///< 0, 1, ..., N-1
+
+    // ==================== Arytmetyka modulo 2^32 ====================
+
+    static constexpr int suma(int x, int y) { return static_cast<int>(static_cast<unsigned>(x) + static_cast<unsigned>(y)); }
+    static constexpr int roznica(int x, int y) { return static_cast<int>(static_cast<unsigned>(x) - static_cast<unsigned>(y)); }
+    static constexpr int iloczyn(int x, int y) { return static_cast<int>(static_cast<unsigned>(x) * static_cast<unsigned>(y)); }
+
+    // ==================== Rozwinięte pętle ====================
+
+    template <class F, int... I>
+    static constexpr macierz_stala generuj(F f, std::integer_sequence<int, I...>) {
+        return macierz_stala(std::array<int, ELEMENTY>{ f(I)... });
+    }
+
+    /// Tworzy macierz, której i-ty element (indeks liniowy) równy jest f(i)
+    template <class F>
+    static constexpr macierz_stala generuj(F f) {
+        return generuj(f, indeksy{});
+    }
+
+    /// Element (i, j) iloczynu a * b: suma a(i, k) * b(k, j) dla k = 0..N-1
+    template <int... K>
+    static constexpr int wiersz_razy_kolumna(const macierz_stala& a, const macierz_stala& b, int i, int j,
+                                             std::integer_sequence<int, K...>) {
+        return static_cast<int>((0u + ... + (static_cast<unsigned>(a.dane[i * N + K]) * static_cast<unsigned>(b.dane[K * N + j]))));
+    }
+
+    template <class P, int... I>
+    static constexpr bool dla_kazdego(P p, std::integer_sequence<int, I...>) {
+        return (p(I) && ...);
+    }
+
+    /// Sprawdza, czy predykat p(i) zachodzi dla każdego indeksu liniowego
+    template <class P>
+    static constexpr bool dla_kazdego(P p) {
+        return dla_kazdego(p, indeksy{});
+    }
+
+public:
+    // ==================== Konstruktory ====================
+
+    /**
+     * @brief Konstruktor domyślny - macierz wypełniona zerami
+     */
+    constexpr macierz_stala() : dane{} {}
+
+    /**
+     * @brief Konstruktor z tablicy elementów (przechowywanych wierszami)
+     * @param t Tablica N*N wartości
+     */
+    constexpr explicit macierz_stala(const std::array<int, ELEMENTY>& t) : dane(t) {}
+
+    /**
+     * @brief Konstruktor kopiujący dane z macierzy dynamicznej
+     * @param m Macierz źródłowa
+     * @throw std::logic_error Jeśli rozmiar m jest różny od N
+     */
+    explicit macierz_stala(const matrix& m) : dane{} {
+        if (m.n != N) throw std::logic_error("Macierze muszą mieć ten sam rozmiar");
+        std::copy(m.macierz_ptr.get(), m.macierz_ptr.get() + ELEMENTY, dane.begin());
+    }
+
+    /**
+     * @brief Tworzy macierz dynamiczną o tych samych elementach
+     * @return Nowa macierz N×N
+     */
+    matrix na_macierz() const {
+        matrix wynik(N, matrix::bez_zerowania_t{});
+        std::copy(dane.begin(), dane.end(), wynik.macierz_ptr.get());
+        return wynik;
+    }
+
+    /**
+     * @brief Konwersja do macierzy dynamicznej (zob. na_macierz)
+     */
+    explicit operator matrix() const { return na_macierz(); }
+
+    // ==================== Dostęp do elementów ====================
+
+    /**
+     * @brief Zwraca referencję do elementu macierzy
+     * @param x Indeks wiersza (0-based)
+     * @param y Indeks kolumny (0-based)
+     * @return Referencja do elementu
+     * @throw std::logic_error Jeśli współrzędne są poza zakresem
+     */
+    constexpr int& at(int x, int y) {
+        if (x >= N || y >= N || x < 0 || y < 0)
+            throw std::logic_error("Zle wspolrzedne macierzy");
+        return dane[x * N + y];
+    }
+
+    /**
+     * @brief Zwraca wartość elementu macierzy
+     * @param x Indeks wiersza (0-based)
+     * @param y Indeks kolumny (0-based)
+     * @return Wartość elementu
+     * @throw std::logic_error Jeśli współrzędne są poza zakresem
+     */
+    constexpr int pokaz(int x, int y) const {
+        if (x >= N || y >= N || x < 0 || y < 0)
+            throw std::logic_error("Zle wspolrzedne macierzy");
+        return dane[x * N + y];
+    }
+
+    /**
+     * @brief Wstawia wartość do macierzy
+     * @param x Indeks wiersza
+     * @param y Indeks kolumny
+     * @param val Wartość do wstawienia
+     */
+    constexpr void wstaw(int x, int y, int val) { at(x, y) = val; }
+
+    /**
+     * @brief Zwraca rozmiar macierzy
+     * @return Rozmiar N
+     */
+    static constexpr int getSize() { return N; }
+
+    // ==================== Transformacje ====================
+
+    /**
+     * @brief Transponuje macierz (zamienia wiersze z kolumnami)
+     * @return Referencja do bieżącej macierzy
+     */
+    constexpr macierz_stala& odwroc() {
+        *this = odwrocona();
+        return *this;
+    }
+
+    /**
+     * @brief Zwraca transpozycję macierzy, nie modyfikując bieżącej
+     * @return Nowa macierz A^T
+     */
+    constexpr macierz_stala odwrocona() const {
+        return generuj([this](int i) { return dane[(i % N) * N + i / N]; });
+    }
+
+    // ==================== Operatory ze skalarami ====================
+
+    /**
+     * @brief Dodaje skalar do wszystkich elementów
+     */
+    constexpr macierz_stala& operator+=(int a) { return *this = *this + a; }
+
+    /**
+     * @brief Odejmuje skalar od wszystkich elementów
+     */
+    constexpr macierz_stala& operator-=(int a) { return *this = *this - a; }
+
+    /**
+     * @brief Mnoży wszystkie elementy przez skalar
+     */
+    constexpr macierz_stala& operator*=(int a) { return *this = *this * a; }
+
+    /**
+     * @brief Postinkrementacja - zwiększa wszystkie elementy o 1
+     * @return Kopia macierzy sprzed inkrementacji
+     */
+    constexpr macierz_stala operator++(int) {
+        macierz_stala poprzednia = *this;
+        *this += 1;
+        return poprzednia;
+    }
+
+    /**
+     * @brief Postdekrementacja - zmniejsza wszystkie elementy o 1
+     * @return Kopia macierzy sprzed dekrementacji
+     */
+    constexpr macierz_stala operator--(int) {
+        macierz_stala poprzednia = *this;
+        *this -= 1;
+        return poprzednia;
+    }
+
+    /**
+     * @brief Operator wywołania - dodaje wartość do wszystkich elementów
+     * @param d Wartość zmiennoprzecinkowa (konwertowana na int)
+     * @return Referencja do bieżącej macierzy
+     */
+    constexpr macierz_stala& operator()(double d) { return *this += static_cast<int>(d); }
+
+    /**
+     * @brief Zwraca macierz z a dodanym do każdego elementu m
+     */
+    friend constexpr macierz_stala operator+(const macierz_stala& m, int a) {
+        return generuj([&](int i) { return suma(m.dane[i], a); });
+    }
+
+    /**
+     * @brief Zwraca macierz z a dodanym do każdego elementu m (a + m)
+     */
+    friend constexpr macierz_stala operator+(int a, const macierz_stala& m) { return m + a; }
+
+    /**
+     * @brief Zwraca macierz z a odjętym od każdego elementu m
+     */
+    friend constexpr macierz_stala operator-(const macierz_stala& m, int a) {
+        return generuj([&](int i) { return roznica(m.dane[i], a); });
+    }
+
+    /**
+     * @brief Zwraca macierz różnic a - m[i][j]
+     */
+    friend constexpr macierz_stala operator-(int a, const macierz_stala& m) {
+        return generuj([&](int i) { return roznica(a, m.dane[i]); });
+    }
+
+    /**
+     * @brief Zwraca macierz z każdym elementem m pomnożonym przez a
+     */
+    friend constexpr macierz_stala operator*(const macierz_stala& m, int a) {
+        return generuj([&](int i) { return iloczyn(m.dane[i], a); });
+    }
+
+    /**
+     * @brief Zwraca macierz z każdym elementem m pomnożonym przez a (a * m)
+     */
+    friend constexpr macierz_stala operator*(int a, const macierz_stala& m) { return m * a; }
+
+    // ==================== Operatory macierzowe ====================
+
+    /**
+     * @brief Dodaje dwie macierze element po elemencie
+     */
+    friend constexpr macierz_stala operator+(const macierz_stala& m1, const macierz_stala& m2) {
+        return generuj([&](int i) { return suma(m1.dane[i], m2.dane[i]); });
+    }
+
+    /**
+     * @brief Mnoży dwie macierze (mnożenie macierzowe, pętle w pełni rozwinięte)
+     */
+    friend constexpr macierz_stala operator*(const macierz_stala& m1, const macierz_stala& m2) {
+        return generuj([&](int i) { return wiersz_razy_kolumna(m1, m2, i / N, i % N, indeksy_k{}); });
+    }
+
+    // ==================== Operatory porównania ====================
+
+    /**
+     * @brief Sprawdza, czy wszystkie elementy są równe (operator!= wyprowadza C++20)
+     */
+    constexpr bool operator==(const macierz_stala& m) const {
+        return dla_kazdego([&](int i) { return dane[i] == m.dane[i]; });
+    }
+
+    /**
+     * @brief Sprawdza, czy każdy element jest większy od odpowiadającego elementu m
+     */
+    constexpr bool operator>(const macierz_stala& m) const {
+        return dla_kazdego([&](int i) { return dane[i] > m.dane[i]; });
+    }
+
+    /**
+     * @brief Sprawdza, czy każdy element jest mniejszy od odpowiadającego elementu m
+     */
+    constexpr bool operator<(const macierz_stala& m) const {
+        return dla_kazdego([&](int i) { return dane[i] < m.dane[i]; });
+    }
+
+    /**
+     * @brief Wypisuje macierz w formacie takim jak dla klasy matrix
+     */
+    friend std::ostream& operator<<(std::ostream& o, const macierz_stala& m) {
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < N; ++j) o << m.dane[i * N + j] << " ";
+            o << "\n";
+        }
+        return o;
+    }
+};
+
+#endif
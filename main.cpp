@@ -6,15 +6,32 @@
  * obejmujący konstruktory, operatory, metody transformacji i wypełniania.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
 #include "matrix.h"
+#include "macierz_bitowa.h"
+#include "macierz_pasmowa.h"
+#include "macierz_rzadka.h"
+#include "macierz_stala.h"
+#include "pakiet_macierzy.h"
+#include "pamiec_iloczynow.h"
+#include "pomiary.h"
+#include "simd.h"
+#include "watki.h"
 
 using namespace std;
 
 /**
  * @brief Główna funkcja programu testowego
  *
- * Przeprowadza 33 testy sprawdzające wszystkie funkcjonalności klasy matrix:
+ * Przeprowadza 57 testów sprawdzające wszystkie funkcjonalności klasy matrix:
  * - Testy konstruktorów (domyślny, parametryczny, z tablicą, kopiujący)
  * - Testy metod dostępu (wstaw, pokaz, at)
  * - Testy transformacji (odwroc, losuj, szachownica)
@@ -26,6 +43,29 @@ using namespace std;
  * - Testy operatorów porównania (==, >, <)
  * - Testy operatora wywołania ()
  * - Testy alokacji pamięci
+ * - Testy zgodności algorytmów mnożenia z wersją naiwną
+ * - Testy puli wątków (zmiana liczby wątków z zadania puli odrzucana)
+ * - Testy zgodności jąder wektorowych (SSE2/AVX2/AVX-512) z wersją skalarną
+ * - Testy leniwych wyrażeń (leniwie)
+ * - Testy operatorów dla obiektów tymczasowych
+ * - Testy przypisania kopiującego i przenoszącego
+ * - Testy puli buforów i wyrównania pamięci
+ * - Testy kafelkowej transpozycji (odwroc, odwrocona)
+ * - Testy macierzy o stałym rozmiarze (macierz_stala)
+ * - Testy macierzy rzadkiej CSR (macierz_rzadka)
+ * - Testy macierzy pasmowej DIA (macierz_pasmowa)
+ * - Testy binarnego formatu plików i wczytywania przez mapowanie
+ * - Testy zapisu i odczytu tekstowego (operator<<, operator>>)
+ * - Testy mnożenia macierzy z plików (mnoz_pliki)
+ * - Testy powtarzalnego losowania z ziarnem
+ * - Testy liczników operacji (pomiary, gdy włączone)
+ * - Testy dostępu bez sprawdzania (row, operator[], data, iteratory)
+ * - Testy potęgowania macierzy (potega, także modulo)
+ * - Testy macierzy logicznej upakowanej bitowo (macierz_bitowa)
+ * - Testy trybów akumulacji mnożenia (sprawdzany, nasycany, modulo)
+ * - Testy pakietów małych macierzy w układzie SoA (pakiet_macierzy)
+ * - Testy porównań wektorowych i skrótu zawartości (skrot, std::hash)
+ * - Testy pamięci iloczynów (LRU z limitem bajtów, statystyki, wątki)
  *
  * @return 0 jeśli wszystkie testy zakończą się sukcesem, 1 w przypadku błędu
  */
@@ -283,6 +323,845 @@ int main() {
         cout << "Macierz po alokacji i wstawieniu danych:" << endl;
         cout << m_alloc << endl;
 
+        // Test 34: Mnożenie blokowe
+        cout << "=== TEST 34: MNOZENIE BLOKOWE ===" << endl;
+        for (int rozmiar : { 1, 5, 17, 97, 300 }) {
+            matrix ra(rozmiar), rb(rozmiar);
+            ra.losuj();
+            rb.losuj();
+            bool zgodne = matrix::mnoz(ra, rb, algorytm_mnozenia::blokowy) == matrix::mnoz(ra, rb, algorytm_mnozenia::naiwny);
+            cout << "n = " << rozmiar << ": zgodnosc z wersja naiwna? " << (zgodne ? "TAK" : "NIE") << endl;
+            if (!zgodne) throw logic_error("Mnozenie blokowe rozni sie od naiwnego");
+        }
+        cout << endl;
+
+        // Test 35: Mnożenie równoległe
+        cout << "=== TEST 35: MNOZENIE ROWNOLEGLE ===" << endl;
+        for (int watkow : { 1, 3, 8 }) {
+            matrix::ustaw_liczbe_watkow(watkow);
+            matrix ra(333), rb(333);
+            ra.losuj();
+            rb.losuj();
+            bool zgodne = matrix::mnoz(ra, rb, algorytm_mnozenia::rownolegly) == matrix::mnoz(ra, rb, algorytm_mnozenia::blokowy);
+            cout << "watkow = " << watkow << ": zgodnosc z wersja blokowa? " << (zgodne ? "TAK" : "NIE") << endl;
+            if (!zgodne) throw logic_error("Mnozenie rownolegle rozni sie od blokowego");
+        }
+        matrix::ustaw_liczbe_watkow(4);
+        std::atomic<int> odrzucone_zmiany{ 0 };
+        bool zmiana_odrzucona = false;
+        try {
+            watki::globalna()->rownolegle_dla(8, [&](int) {
+                try {
+                    matrix::ustaw_liczbe_watkow(2);
+                }
+                catch (logic_error&) {
+                    ++odrzucone_zmiany;
+                }
+                watki::globalna()->rownolegle_dla(4, [](int) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+            });
+            watki::globalna()->rownolegle_dla(1, [](int) { matrix::ustaw_liczbe_watkow(2); });
+        }
+        catch (logic_error&) {
+            zmiana_odrzucona = true;
+        }
+        zmiana_odrzucona = zmiana_odrzucona && odrzucone_zmiany == 8 && matrix::liczba_watkow() == 4;
+        cout << "Zmiana liczby watkow z zadania puli odrzucona? " << (zmiana_odrzucona ? "TAK" : "NIE") << endl;
+        if (!zmiana_odrzucona) throw logic_error("Zmiana liczby watkow z zadania puli nie zostala odrzucona");
+        matrix::ustaw_liczbe_watkow(0);
+        cout << endl;
+
+        // Test 36: Mnożenie Strassena
+        cout << "=== TEST 36: MNOZENIE STRASSENA ===" << endl;
+        matrix::ustaw_prog_strassena(16);
+        for (int rozmiar : { 15, 64, 101, 250 }) {
+            matrix ra(rozmiar), rb(rozmiar);
+            ra.losuj(100);
+            rb.losuj(100);
+            ra -= 50;
+            bool zgodne = matrix::mnoz(ra, rb, algorytm_mnozenia::strassen) == matrix::mnoz(ra, rb, algorytm_mnozenia::naiwny);
+            cout << "n = " << rozmiar << ": zgodnosc z wersja naiwna? " << (zgodne ? "TAK" : "NIE") << endl;
+            if (!zgodne) throw logic_error("Mnozenie Strassena rozni sie od naiwnego");
+        }
+        matrix::ustaw_prog_strassena(512);
+        cout << endl;
+
+        // Test 37: Jądra wektorowe
+        cout << "=== TEST 37: JADRA WEKTOROWE ===" << endl;
+        simd::poziom_isa wykryty = simd::wykryty_poziom();
+        simd::ustaw_poziom(simd::poziom_isa::skalarny);
+        matrix wzor(37);
+        wzor.losuj(1000);
+        wzor -= 500;
+        matrix wzor_po = wzor;
+        matrix wzor_przed = wzor_po++;
+        matrix wzory[] = { wzor + 7, 7 + wzor, wzor - 7, 7 - wzor, wzor * -3, -3 * wzor, wzor + wzor, wzor_po, wzor_przed };
+        for (simd::poziom_isa p : { simd::poziom_isa::sse2, simd::poziom_isa::avx2, simd::poziom_isa::avx512 }) {
+            if (p > wykryty) continue;
+            simd::ustaw_poziom(p);
+            matrix po = wzor;
+            matrix przed = po++;
+            matrix wyniki[] = { wzor + 7, 7 + wzor, wzor - 7, 7 - wzor, wzor * -3, -3 * wzor, wzor + wzor, po, przed };
+            bool zgodne = true;
+            for (int i = 0; i < 9; ++i) zgodne = zgodne && wyniki[i] == wzory[i];
+            cout << simd::nazwa(p) << ": zgodnosc z wersja skalarna? " << (zgodne ? "TAK" : "NIE") << endl;
+            if (!zgodne) throw logic_error("Jadro wektorowe rozni sie od skalarnego");
+        }
+        simd::ustaw_poziom(wykryty);
+        cout << endl;
+
+        // Test 38: Leniwe wyrażenia
+        cout << "=== TEST 38: LENIWE WYRAZENIA ===" << endl;
+        matrix wa(3, tab), wb(3, tab2);
+        matrix leniwy = (leniwie(wa) + wb) * 3 - 1;
+        cout << "(A + B) * 3 - 1:" << endl << leniwy << endl;
+        bool zgodne_leniwe = leniwy == (wa + wb) * 3 - 1
+            && matrix(10 - leniwie(wa) * 2) == 10 - wa * 2
+            && matrix(-leniwie(wa) + wb) == 0 - wa + wb;
+        wa = leniwie(wa) * 2 + wb;
+        zgodne_leniwe = zgodne_leniwe && wa == matrix(3, tab) * 2 + wb;
+        // Przypisanie do macierzy z za małym buforem i do pustej
+        matrix za_mala(1), pusta;
+        za_mala = leniwie(wb) * 2 + 1;
+        pusta = leniwie(wb) - 1;
+        zgodne_leniwe = zgodne_leniwe && za_mala == wb * 2 + 1 && pusta == wb - 1;
+        cout << "Zgodnosc z operatorami zachlannymi? " << (zgodne_leniwe ? "TAK" : "NIE") << endl << endl;
+        if (!zgodne_leniwe) throw logic_error("Leniwe wyrazenie rozni sie od zachlannego");
+
+        // Test 39: Operatory dla obiektów tymczasowych
+        cout << "=== TEST 39: OPERATORY DLA OBIEKTOW TYMCZASOWYCH ===" << endl;
+        matrix ta(3, tab), tb(3, tab2);
+        matrix lancuch = 2 * (10 - (ta + tb) * 3 + 1) - 4 + (tb + tb);
+        int tab_lancuch[9];
+        for (int i = 0; i < 9; ++i) tab_lancuch[i] = 2 * (10 - (tab[i] + tab2[i]) * 3 + 1) - 4 + 2 * tab2[i];
+        bool zgodne_tymczasowe = lancuch == matrix(3, tab_lancuch) && ta == matrix(3, tab) && tb == matrix(3, tab2);
+        cout << "2 * (10 - (A + B) * 3 + 1) - 4 + (B + B):" << endl << lancuch << endl;
+        cout << "Zgodnosc z wynikiem oczekiwanym? " << (zgodne_tymczasowe ? "TAK" : "NIE") << endl << endl;
+        if (!zgodne_tymczasowe) throw logic_error("Operatory dla obiektow tymczasowych daja zly wynik");
+
+        // Test 40: Przypisanie kopiujące i przenoszące
+        cout << "=== TEST 40: PRZYPISANIE KOPIUJACE I PRZENOSZACE ===" << endl;
+        matrix cel(5);
+        cel.losuj();
+        matrix zrodlo(3, tab);
+        cel = zrodlo;
+        cel = cel;
+        cout << "Po przypisaniu 3x3 do macierzy 5x5:" << endl << cel << endl;
+        matrix przeniesiona;
+        przeniesiona = std::move(cel);
+        bool zgodne_przypisanie = przeniesiona == zrodlo && cel.getSize() == 0;
+        cel = zrodlo * 2;
+        zgodne_przypisanie = zgodne_przypisanie && cel == zrodlo + zrodlo;
+        cout << "Zgodnosc kopii i przeniesienia? " << (zgodne_przypisanie ? "TAK" : "NIE") << endl << endl;
+        if (!zgodne_przypisanie) throw logic_error("Przypisanie daje zly wynik");
+
+        // Test 41: Pula buforów
+        cout << "=== TEST 41: PULA BUFOROW ===" << endl;
+        pamiec::zeruj_statystyki();
+        matrix baza(64);
+        baza.losuj();
+        for (int i = 0; i < 100; ++i) {
+            matrix tymczasowa = baza + i;
+            if (tymczasowa.pokaz(0, 0) != baza.pokaz(0, 0) + i) throw logic_error("Bufor z puli ma zla zawartosc");
+        }
+        pamiec::statystyki st = pamiec::pobierz_statystyki();
+        cout << st << endl;
+        bool wyrownane = reinterpret_cast<std::uintptr_t>(&baza.at(0, 0)) % pamiec::WYROWNANIE == 0;
+        cout << "Bufory z puli: " << (st.z_puli >= 99 ? "TAK" : "NIE") << ", wyrownanie do 64 B: " << (wyrownane ? "TAK" : "NIE") << endl << endl;
+        if (st.z_puli < 99 || !wyrownane) throw logic_error("Pula buforow nie dziala");
+
+        // Test 42: Kafelkowa transpozycja
+        cout << "=== TEST 42: KAFELKOWA TRANSPOZYCJA ===" << endl;
+        for (int rozmiar : { 1, 7, 8, 9, 31, 64, 100, 257 }) {
+            matrix zrodlo(rozmiar);
+            zrodlo.losuj(1000);
+            for (simd::poziom_isa p : { simd::poziom_isa::skalarny, simd::poziom_isa::sse2, simd::poziom_isa::avx2 }) {
+                if (p > wykryty) continue;
+                simd::ustaw_poziom(p);
+                matrix w_miejscu = zrodlo;
+                w_miejscu.odwroc();
+                matrix poza = zrodlo.odwrocona();
+                bool zgodne = true;
+                for (int i = 0; i < rozmiar && zgodne; ++i)
+                    for (int j = 0; j < rozmiar && zgodne; ++j)
+                        zgodne = w_miejscu.pokaz(i, j) == zrodlo.pokaz(j, i) && poza.pokaz(i, j) == zrodlo.pokaz(j, i);
+                if (!zgodne) throw logic_error("Transpozycja rozni sie od naiwnej");
+            }
+            cout << "n=" << rozmiar << ": zgodnosc z transpozycja naiwna? TAK" << endl;
+        }
+        simd::ustaw_poziom(wykryty);
+        cout << endl;
+
+        // Test 43: Macierz o stałym rozmiarze
+        cout << "=== TEST 43: MACIERZ O STALYM ROZMIARZE ===" << endl;
+        constexpr macierz_stala<2> stala_a{ { 1, 2, 3, 4 } };
+        constexpr macierz_stala<2> stala_b = stala_a * stala_a + 1;
+        static_assert(stala_b == macierz_stala<2>{ { 8, 11, 16, 23 } }, "constexpr mnozenie");
+        static_assert(stala_a.odwrocona().pokaz(0, 1) == 3, "constexpr transpozycja");
+        static_assert(stala_b > stala_a && stala_a < stala_b, "constexpr porownanie");
+        static_assert(stala_a != stala_b && !(stala_a != macierz_stala<2>{ { 1, 2, 3, 4 } }), "constexpr nierownosc");
+        static_assert([] {
+            macierz_stala<2> m{ { 1, 2, 3, 4 } };
+            macierz_stala<2> przed = m++;
+            return przed == macierz_stala<2>{ { 1, 2, 3, 4 } } && m == macierz_stala<2>{ { 2, 3, 4, 5 } };
+        }(), "constexpr postinkrementacja");
+        static_assert([] {
+            macierz_stala<2> m{ { 1, 2, 3, 4 } };
+            macierz_stala<2> przed = m--;
+            return przed == macierz_stala<2>{ { 1, 2, 3, 4 } } && m == macierz_stala<2>{ { 0, 1, 2, 3 } };
+        }(), "constexpr postdekrementacja");
+        static_assert(macierz_stala<2>{ { 1, 2, 3, 4 } }(2.7)(-0.5) == macierz_stala<2>{ { 3, 4, 5, 6 } }, "constexpr operator()");
+        auto sprawdz_stala = [](auto wzor) {
+            using stala = decltype(wzor);
+            constexpr int rozmiar = stala::ROZMIAR;
+            matrix d1(rozmiar), d2(rozmiar);
+            d1.losuj(1000);
+            d2.losuj(1000);
+            stala s1(d1), s2(d2);
+            bool zgodne = (s1 * s2).na_macierz() == d1 * d2
+                && (s1 + s2).na_macierz() == d1 + d2
+                && (s1 * -3).na_macierz() == d1 * -3
+                && (7 - s1).na_macierz() == 7 - d1
+                && stala(s1).odwroc().na_macierz() == matrix(d1).odwroc()
+                && (s1 == stala(d1)) && !(s1 == s2)
+                && stala(s1)(-4.9).na_macierz() == matrix(d1)(-4.9)
+                && [&] { stala s = s1, przed = s++; matrix d = d1, d_przed = d++; return przed.na_macierz() == d_przed && s.na_macierz() == d; }()
+                && [&] { stala s = s1, przed = s--; matrix d = d1, d_przed = d--; return przed.na_macierz() == d_przed && s.na_macierz() == d; }()
+                && (s1 + 1 > s1) == (d1 + 1 > d1) && (s1 < s1 + 1) == (d1 < d1 + 1);
+            cout << rozmiar << "x" << rozmiar << ": zgodnosc z klasa matrix? " << (zgodne ? "TAK" : "NIE") << endl;
+            if (!zgodne) throw logic_error("macierz_stala rozni sie od matrix");
+        };
+        sprawdz_stala(macierz_stala<2>{});
+        sprawdz_stala(macierz_stala<3>{});
+        sprawdz_stala(macierz_stala<4>{});
+        sprawdz_stala(macierz_stala<8>{});
+        try {
+            macierz_stala<3> zly_rozmiar(matrix(4));
+            throw runtime_error("Brak wyjatku dla zlego rozmiaru");
+        }
+        catch (logic_error&) {
+            cout << "Wyjatek dla macierzy 4x4 -> macierz_stala<3>: TAK" << endl;
+        }
+        cout << endl;
+
+        // Test 44: Macierz rzadka CSR
+        cout << "=== TEST 44: MACIERZ RZADKA CSR ===" << endl;
+        matrix gesta_a(100), gesta_b(100);
+        gesta_a.losuj(1000);
+        gesta_b.losuj(1000);
+        for (int i = 0; i < 100; ++i) {
+            for (int j = 0; j < 100; ++j) {
+                if ((i * 7 + j * 13) % 29 != 0) gesta_a.wstaw(i, j, 0);
+                if ((i * 11 + j * 5) % 31 != 0) gesta_b.wstaw(i, j, 0);
+            }
+        }
+        macierz_rzadka rzadka_a(gesta_a), rzadka_b(gesta_b);
+        cout << "Niezerowe elementy A: " << rzadka_a.niezerowe() << " z " << 100 * 100 << endl;
+        bool zgodne_rzadkie = rzadka_a.na_macierz() == gesta_a
+            && rzadka_a * gesta_b == gesta_a * gesta_b
+            && gesta_a * rzadka_b == gesta_a * gesta_b
+            && (rzadka_a * rzadka_b).na_macierz() == gesta_a * gesta_b
+            && rzadka_a.odwrocona().na_macierz() == matrix(gesta_a).odwroc()
+            && rzadka_a.pokaz(0, 0) == gesta_a.pokaz(0, 0) && rzadka_a.pokaz(1, 2) == gesta_a.pokaz(1, 2);
+        int wartosci_k[99];
+        for (int i = 0; i < 99; ++i) wartosci_k[i] = i + 1;
+        matrix gesta_k(100);
+        gesta_k.diagonalna_k(-1, wartosci_k);
+        zgodne_rzadkie = zgodne_rzadkie && macierz_rzadka::diagonalna_k(100, -1, wartosci_k).na_macierz() == gesta_k
+            && macierz_rzadka(100, { { 5, 7, 2 }, { 5, 7, -2 }, { 3, 1, 4 }, { 3, 1, 1 } }) == macierz_rzadka(100, { { 3, 1, 5 } });
+        cout << "Zgodnosc z mnozeniem gestym (S*D, D*S, S*S, transpozycja)? " << (zgodne_rzadkie ? "TAK" : "NIE") << endl;
+        if (!zgodne_rzadkie) throw logic_error("Macierz rzadka rozni sie od gestej");
+        macierz_rzadka duza = macierz_rzadka::przekatna(1000000);
+        macierz_rzadka duza_kwadrat = duza * duza;
+        cout << "Jednostkowa 1000000x1000000 do kwadratu: " << duza_kwadrat.niezerowe() << " niezerowych elementow" << endl << endl;
+        if (!(duza_kwadrat == duza)) throw logic_error("Zly kwadrat macierzy jednostkowej");
+
+        // Test 45: Macierz pasmowa DIA
+        cout << "=== TEST 45: MACIERZ PASMOWA DIA ===" << endl;
+        int pasmo[50];
+        macierz_pasmowa pasmowa_a(50), pasmowa_b(50);
+        matrix gesta_pa(50), gesta_pb(50);
+        for (int k : { -2, 0, 1, 3 }) {
+            for (int i = 0; i < 50; ++i) pasmo[i] = i * 3 + k - 40;
+            pasmowa_a.diagonalna_k(k, pasmo);
+            gesta_pa.diagonalna_k(k, pasmo);
+            pasmowa_b.diagonalna_k(-k, pasmo);
+            gesta_pb.diagonalna_k(-k, pasmo);
+        }
+        bool zgodne_pasmowe = pasmowa_a.na_macierz() == gesta_pa
+            && (pasmowa_a * pasmowa_b).na_macierz() == gesta_pa * gesta_pb
+            && (pasmowa_a + pasmowa_b).na_macierz() == gesta_pa + gesta_pb
+            && pasmowa_a.odwrocona().na_macierz() == matrix(gesta_pa).odwroc()
+            && macierz_pasmowa(gesta_pa) == pasmowa_a
+            && pasmowa_a.pokaz(4, 2) == gesta_pa.pokaz(4, 2) && pasmowa_a.szerokosc_pasma() == 3;
+        cout << "Zgodnosc z macierza gesta (*, +, transpozycja)? " << (zgodne_pasmowe ? "TAK" : "NIE") << endl;
+        if (!zgodne_pasmowe) throw logic_error("Macierz pasmowa rozni sie od gestej");
+        std::vector<int> jedynki(100000, 1);
+        macierz_pasmowa trojdiagonalna(100000);
+        for (int k : { -1, 0, 1 }) trojdiagonalna.diagonalna_k(k, jedynki.data());
+        macierz_pasmowa piecio = trojdiagonalna * trojdiagonalna;
+        cout << "Trojdiagonalna 100000x100000 do kwadratu: " << piecio.liczba_przekatnych() << " przekatnych, srodek "
+            << piecio.pokaz(500, 500) << ", rog " << piecio.pokaz(0, 0) << endl << endl;
+        if (piecio.liczba_przekatnych() != 5 || piecio.pokaz(500, 500) != 3 || piecio.pokaz(0, 0) != 2 || piecio.pokaz(500, 502) != 1)
+            throw logic_error("Zly kwadrat macierzy trojdiagonalnej");
+
+        // Test 46: Pliki binarne
+        cout << "=== TEST 46: PLIKI BINARNE ===" << endl;
+        matrix do_zapisu(300);
+        do_zapisu.losuj(1000000);
+        do_zapisu.zapisz("test_macierz.bin");
+        pamiec::zeruj_statystyki();
+        matrix wczytana = matrix::wczytaj("test_macierz.bin");
+        pamiec::statystyki st_pliku = pamiec::pobierz_statystyki();
+        bool zgodna_z_plikiem = wczytana == do_zapisu;
+        bool wyrownana = reinterpret_cast<std::uintptr_t>(&wczytana.at(0, 0)) % pamiec::WYROWNANIE == 0;
+        wczytana += 5;
+        zgodna_z_plikiem = zgodna_z_plikiem && matrix::wczytaj("test_macierz.bin") == do_zapisu && wczytana == do_zapisu + 5;
+        cout << "Wczytana zgodna z zapisana (plik bez zmian po modyfikacji)? " << (zgodna_z_plikiem ? "TAK" : "NIE")
+            << ", bajty skopiowane do nowych buforow: " << st_pliku.bajty_systemu << ", wyrownanie do 64 B: " << (wyrownana ? "TAK" : "NIE") << endl;
+        if (!zgodna_z_plikiem || !wyrownana) throw logic_error("Wczytana macierz rozni sie od zapisanej");
+        // Zapis do pliku, który wciąż jest zmapowany jako bufor wczytanej macierzy
+        matrix edytowana = matrix::wczytaj("test_macierz.bin");
+        edytowana.at(0, 0) = 5;
+        edytowana.zapisz("test_macierz.bin");
+        matrix po_edycji = do_zapisu;
+        po_edycji.at(0, 0) = 5;
+        bool zapis_w_miejscu = edytowana == po_edycji && matrix::wczytaj("test_macierz.bin") == po_edycji;
+        cout << "Wczytana, zmieniona i zapisana do tego samego pliku? " << (zapis_w_miejscu ? "TAK" : "NIE") << endl;
+        if (!zapis_w_miejscu) throw logic_error("Zapis do pliku zmapowanej macierzy nie powiodl sie");
+        {
+            std::FILE* zly = std::fopen("test_macierz.bin", "r+b");
+            std::fputc('X', zly);
+            std::fclose(zly);
+        }
+        bool odrzucony = false;
+        try {
+            matrix::wczytaj("test_macierz.bin");
+        }
+        catch (logic_error& e) {
+            odrzucony = true;
+            cout << "Uszkodzony naglowek: " << e.what() << endl;
+        }
+        std::remove("test_macierz.bin");
+        cout << endl;
+        if (!odrzucony) throw logic_error("Uszkodzony plik zostal wczytany");
+
+        // Test 47: Zapis i odczyt tekstowy
+        cout << "=== TEST 47: ZAPIS I ODCZYT TEKSTOWY ===" << endl;
+        matrix tekstowa(200);
+        tekstowa.losuj(1000000);
+        tekstowa *= -4099;
+        std::stringstream strumien;
+        strumien << tekstowa << m1;
+        matrix odczytana, odczytana_m1;
+        strumien >> odczytana >> odczytana_m1;
+        bool zgodne_tekstowo = strumien && odczytana == tekstowa && odczytana_m1 == m1;
+        std::ostringstream wzor_tekstu;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) wzor_tekstu << m1.pokaz(i, j) << " ";
+            wzor_tekstu << "\n";
+        }
+        std::ostringstream tekst_m1;
+        tekst_m1 << m1;
+        zgodne_tekstowo = zgodne_tekstowo && tekst_m1.str() == wzor_tekstu.str();
+        std::istringstream zly_tekst("1 2 3\n4 x 6\n7 8 9\n");
+        matrix bez_zmian = m1;
+        zly_tekst >> bez_zmian;
+        zgodne_tekstowo = zgodne_tekstowo && zly_tekst.fail() && bez_zmian == m1;
+        std::stringstream z_separatorem;
+        z_separatorem << m1 << endl << tekstowa << endl << " \t\n";
+        matrix pierwsza, druga, trzecia = m1;
+        z_separatorem >> pierwsza >> druga;
+        zgodne_tekstowo = zgodne_tekstowo && z_separatorem && pierwsza == m1 && druga == tekstowa;
+        z_separatorem >> trzecia;
+        zgodne_tekstowo = zgodne_tekstowo && z_separatorem.fail() && trzecia == m1;
+        cout << "Odczyt zgodny z zapisem (kolejne macierze, puste linie, bledne dane)? " << (zgodne_tekstowo ? "TAK" : "NIE") << endl << endl;
+        if (!zgodne_tekstowo) throw logic_error("Odczyt tekstowy rozni sie od zapisu");
+
+        // Test 48: Mnożenie macierzy z plików
+        cout << "=== TEST 48: MNOZENIE MACIERZY Z PLIKOW ===" << endl;
+        for (int rozmiar : { 37, 100 }) {
+            matrix plikowa_a(rozmiar), plikowa_b(rozmiar);
+            plikowa_a.losuj(1000);
+            plikowa_b.losuj(1000);
+            plikowa_b -= 500;
+            plikowa_a.zapisz("test_a.bin");
+            plikowa_b.zapisz("test_b.bin");
+            matrix::mnoz_pliki("test_a.bin", "test_b.bin", "test_c.bin", 8192);
+            bool zgodne_plikowe = matrix::wczytaj("test_c.bin") == plikowa_a * plikowa_b;
+            // Wynik w miejscu jednego z argumentów
+            matrix::mnoz_pliki("test_a.bin", "test_b.bin", "test_a.bin", 8192);
+            matrix::mnoz_pliki("test_b.bin", "test_b.bin", "test_b.bin", 8192);
+            zgodne_plikowe = zgodne_plikowe && matrix::wczytaj("test_a.bin") == plikowa_a * plikowa_b
+                && matrix::wczytaj("test_b.bin") == plikowa_b * plikowa_b;
+            cout << "n=" << rozmiar << ", kafle 16x16 (limit 8 KiB, takze wynik w miejscu A i B): zgodnosc z mnozeniem w pamieci? " << (zgodne_plikowe ? "TAK" : "NIE") << endl;
+            if (!zgodne_plikowe) throw logic_error("Mnozenie z plikow rozni sie od mnozenia w pamieci");
+        }
+        matrix().zapisz("test_0.bin");
+        matrix::mnoz_pliki("test_0.bin", "test_0.bin", "test_0.bin", 8192);
+        bool pusty_w_miejscu = matrix::wczytaj("test_0.bin").getSize() == 0;
+        std::remove("test_0.bin");
+        cout << "n=0, wynik w miejscu argumentow: pusta macierz? " << (pusty_w_miejscu ? "TAK" : "NIE") << endl;
+        if (!pusty_w_miejscu) throw logic_error("Mnozenie pustych macierzy z plikow niepoprawne");
+        bool za_maly_limit = false;
+        try {
+            matrix::mnoz_pliki("test_a.bin", "test_b.bin", "test_c.bin", 1024);
+        }
+        catch (logic_error&) {
+            za_maly_limit = true;
+        }
+        std::remove("test_a.bin");
+        std::remove("test_b.bin");
+        std::remove("test_c.bin");
+        cout << "Wyjatek dla zbyt malego limitu pamieci: " << (za_maly_limit ? "TAK" : "NIE") << endl << endl;
+        if (!za_maly_limit) throw logic_error("Brak wyjatku dla zbyt malego limitu");
+
+        // Test 49: Powtarzalne losowanie z ziarnem
+        cout << "=== TEST 49: LOSOWANIE Z ZIARNEM ===" << endl;
+        matrix::ustaw_liczbe_watkow(1);
+        matrix los_1(500);
+        los_1.losuj(1000, 42);
+        matrix::ustaw_liczbe_watkow(4);
+        matrix los_4(500), los_inne(500);
+        los_4.losuj(1000, 42);
+        los_inne.losuj(1000, 43);
+        matrix::ustaw_liczbe_watkow(0);
+        bool w_zakresie = true;
+        for (int i = 0; i < 500; ++i)
+            for (int j = 0; j < 500; ++j) w_zakresie = w_zakresie && los_1.pokaz(i, j) >= 0 && los_1.pokaz(i, j) <= 1000;
+        cout << "Ziarno 42 przy 1 i 4 watkach daje te sama macierz? " << (los_1 == los_4 ? "TAK" : "NIE")
+            << ", inne ziarno inna macierz? " << (los_1 == los_inne ? "NIE" : "TAK")
+            << ", wartosci w [0, 1000]? " << (w_zakresie ? "TAK" : "NIE") << endl << endl;
+        if (!(los_1 == los_4) || los_1 == los_inne || !w_zakresie) throw logic_error("Losowanie z ziarnem nie jest powtarzalne");
+
+        // Test 50: Liczniki operacji
+        cout << "=== TEST 50: LICZNIKI OPERACJI ===" << endl;
+        pomiary::zeruj();
+        matrix mierzona(64);
+        mierzona.losuj(9, 7);
+        for (int i = 0; i < 3; ++i) {
+            matrix iloczyn_mierzony = mierzona * mierzona;
+            matrix tymczasowa_mierzona = iloczyn_mierzony * 2 + 1;
+        }
+        mierzona.alokuj(128);
+        pomiary::migawka mig = pomiary::pobierz();
+        const pomiary::liczniki& mnozenia = mig.operacje[static_cast<int>(pomiary::operacja::mnozenie)];
+        const pomiary::liczniki& tymczasowe = mig.operacje[static_cast<int>(pomiary::operacja::tymczasowa)];
+        const pomiary::liczniki& alokacje_alokuj = mig.operacje[static_cast<int>(pomiary::operacja::alokuj)];
+        bool liczniki_ok;
+        if (pomiary::wlaczone()) {
+            cout << mig;
+            liczniki_ok = mnozenia.wywolania == 3 && mnozenia.elementy == 3u * 64 * 64 * 64 && mnozenia.alokacje >= 3
+                && tymczasowe.wywolania == 3 && tymczasowe.alokacje == 0 && alokacje_alokuj.alokacje == 1;
+        }
+        else {
+            cout << "Pomiary wylaczone (MATRIX_POMIARY) - liczniki zerowe" << endl;
+            liczniki_ok = mnozenia.wywolania == 0 && tymczasowe.wywolania == 0;
+        }
+        cout << "Liczniki zgodne z wykonanymi operacjami? " << (liczniki_ok ? "TAK" : "NIE") << endl << endl;
+        if (!liczniki_ok) throw logic_error("Liczniki operacji sa niepoprawne");
+
+        // Test 51: Dostęp bez sprawdzania
+        cout << "=== TEST 51: DOSTEP BEZ SPRAWDZANIA ===" << endl;
+        matrix widoki(5);
+        widoki.losuj(100, 3);
+        bool zgodny_dostep = widoki.data() == &widoki.at(0, 0) && widoki.end() - widoki.begin() == 25
+            && widoki.row(2).size() == 5u && &widoki.row(2)[3] == &widoki.at(2, 3);
+        for (int i = 0; i < 5; ++i)
+            for (int j = 0; j < 5; ++j) zgodny_dostep = zgodny_dostep && widoki[i][j] == widoki.pokaz(i, j);
+        widoki[1][4] = -7;
+        std::sort(widoki.row(0).begin(), widoki.row(0).end());
+        zgodny_dostep = zgodny_dostep && widoki.pokaz(1, 4) == -7 && std::is_sorted(widoki.row(0).begin(), widoki.row(0).end())
+            && *std::min_element(widoki.cbegin(), widoki.cend()) == -7;
+        matrix wzorce(6);
+        int wartosci_w[6] = { 1, 2, 3, 4, 5, 6 };
+        for (int i = 0; i < 6; ++i) {
+            for (int j = 0; j < 6; ++j) {
+                zgodny_dostep = zgodny_dostep && wzorce.szachownica().pokaz(i, j) == (i + j) % 2
+                    && wzorce.przekatna().pokaz(i, j) == (i == j) && wzorce.pod_przekatna().pokaz(i, j) == (i > j)
+                    && wzorce.nad_przekatna().pokaz(i, j) == (i < j);
+            }
+            zgodny_dostep = zgodny_dostep && wzorce.kolumna(2, wartosci_w).pokaz(i, 2) == wartosci_w[i]
+                && wzorce.wiersz(3, wartosci_w).pokaz(3, i) == wartosci_w[i];
+        }
+        for (int k : { -5, -2, 3, 5, 6, -6 }) {
+            matrix k_ta(6);
+            k_ta.diagonalna_k(k, wartosci_w);
+            for (int i = 0; i < 6; ++i)
+                for (int j = 0; j < 6; ++j)
+                    zgodny_dostep = zgodny_dostep && k_ta.pokaz(i, j) == (j - i == k ? wartosci_w[k > 0 ? i : j] : 0);
+        }
+        cout << "Widoki wierszy, operator[], data i iteratory zgodne z at()? " << (zgodny_dostep ? "TAK" : "NIE") << endl << endl;
+        if (!zgodny_dostep) throw logic_error("Dostep bez sprawdzania rozni sie od at()");
+
+        // Test 52: Potęgowanie
+        cout << "=== TEST 52: POTEGOWANIE ===" << endl;
+        matrix sciezki(6);
+        sciezki.nad_przekatna();
+        // Liczba ścieżek długości 2 z i do j w grafie i -> j (i < j) to j - i - 1
+        matrix dwa_kroki = sciezki.potega(2);
+        bool zgodna_potega = dwa_kroki == sciezki * sciezki && sciezki.potega(6) == matrix(6)
+            && sciezki.potega(1) == sciezki && sciezki.potega(0) == matrix(6).przekatna();
+        for (int i = 0; i < 6; ++i)
+            for (int j = 0; j < 6; ++j) zgodna_potega = zgodna_potega && dwa_kroki.pokaz(i, j) == (j > i ? j - i - 1 : 0);
+        matrix do_potegi(37);
+        do_potegi.losuj(1000, 11);
+        do_potegi.wstaw(0, 0, -5);
+        matrix iloczyny(37);
+        iloczyny.przekatna();
+        for (int k = 1; k <= 13; ++k) {
+            iloczyny = iloczyny * do_potegi;
+            zgodna_potega = zgodna_potega && do_potegi.potega(k) == iloczyny;
+        }
+        const int modul = 1000000007;
+        matrix iloczyny_mod(37);
+        iloczyny_mod.przekatna();
+        for (int k = 1; k <= 13; ++k) {
+            // Referencyjne mnożenie modulo na 64 bitach
+            matrix nowa(37);
+            for (int i = 0; i < 37; ++i)
+                for (int j = 0; j < 37; ++j) {
+                    long long suma = 0;
+                    for (int l = 0; l < 37; ++l) {
+                        long long a = (do_potegi.pokaz(l, j) % modul + modul) % modul;
+                        suma = (suma + iloczyny_mod.pokaz(i, l) * a) % modul;
+                    }
+                    nowa.wstaw(i, j, static_cast<int>(suma));
+                }
+            iloczyny_mod = nowa;
+            zgodna_potega = zgodna_potega && do_potegi.potega(k, modul) == iloczyny_mod;
+        }
+        matrix fibonacci(2);
+        fibonacci.wstaw(0, 0, 1);
+        fibonacci.wstaw(0, 1, 1);
+        fibonacci.wstaw(1, 0, 1);
+        // F(90) mod 2^31-1 i F(1000) mod 10^9+7
+        zgodna_potega = zgodna_potega && fibonacci.potega(90, 2147483647).pokaz(0, 1) == static_cast<int>(2880067194370816120LL % 2147483647)
+            && fibonacci.potega(1000, modul).pokaz(0, 1) == 517691607 && fibonacci.potega(0, 1) == matrix(2)
+            && fibonacci.potega(100, 1) == matrix(2);
+        bool odrzucona_potega = false;
+        try { fibonacci.potega(-1); }
+        catch (logic_error&) { odrzucona_potega = true; }
+        try { fibonacci.potega(2, 0); odrzucona_potega = false; }
+        catch (logic_error&) {}
+        cout << "Potegi zgodne z kolejnymi mnozeniami (takze modulo)? " << (zgodna_potega && odrzucona_potega ? "TAK" : "NIE") << endl << endl;
+        if (!zgodna_potega || !odrzucona_potega) throw logic_error("Potegowanie daje zly wynik");
+
+        // Test 53: Macierz bitowa
+        cout << "=== TEST 53: MACIERZ BITOWA ===" << endl;
+        bool zgodna_bitowa = true;
+        for (int rozmiar : { 1, 7, 63, 64, 65, 130 }) {
+            matrix gesta_x(rozmiar), gesta_y(rozmiar);
+            gesta_x.losuj(1, 100 + rozmiar);
+            gesta_y.losuj(3, 200 + rozmiar);
+            macierz_bitowa bit_x(gesta_x), bit_y(gesta_y);
+            matrix zero_jeden_y(macierz_bitowa(gesta_y).na_macierz());
+            matrix iloczyn_gesty = gesta_x * zero_jeden_y;
+            matrix logiczny(rozmiar), koniunkcja(rozmiar), alternatywa(rozmiar), roznica(rozmiar);
+            for (int i = 0; i < rozmiar; ++i)
+                for (int j = 0; j < rozmiar; ++j) {
+                    bool x = gesta_x.pokaz(i, j) != 0, y = gesta_y.pokaz(i, j) != 0;
+                    logiczny.wstaw(i, j, iloczyn_gesty.pokaz(i, j) != 0);
+                    koniunkcja.wstaw(i, j, x && y);
+                    alternatywa.wstaw(i, j, x || y);
+                    roznica.wstaw(i, j, x != y);
+                }
+            zgodna_bitowa = zgodna_bitowa && bit_x.na_macierz() == gesta_x && (bit_x * bit_y).na_macierz() == logiczny
+                && iloczyn_zliczajacy(bit_x, bit_y) == iloczyn_gesty
+                && (bit_x & bit_y).na_macierz() == koniunkcja && (bit_x | bit_y).na_macierz() == alternatywa
+                && (bit_x ^ bit_y).na_macierz() == roznica && bit_y.odwrocona().na_macierz() == zero_jeden_y.odwrocona()
+                && bit_x * macierz_bitowa::jednostkowa(rozmiar) == bit_x;
+        }
+        macierz_bitowa krawedzie(matrix(9).nad_przekatna());
+        krawedzie.wstaw(8, 0, true).wstaw(3, 5, false);
+        zgodna_bitowa = zgodna_bitowa && krawedzie.pokaz(8, 0) && !krawedzie.pokaz(3, 5) && krawedzie.niezerowe() == 36
+            && macierz_bitowa(matrix(70).szachownica()).niezerowe() == 70 * 35
+            && iloczyn_zliczajacy(krawedzie, krawedzie).pokaz(0, 2) == 1;
+        // Osiągalność w grafie ścieżki 0 -> 1 -> ... -> 299: domknięcie przez podnoszenie (I | A) do kwadratu
+        int wierzcholki = 300;
+        macierz_bitowa sciezka(wierzcholki);
+        for (int i = 0; i + 1 < wierzcholki; ++i) sciezka.wstaw(i, i + 1, true);
+        macierz_bitowa osiagalne = sciezka | macierz_bitowa::jednostkowa(wierzcholki);
+        for (int krok = 1; krok < wierzcholki; krok *= 2) osiagalne = osiagalne * osiagalne;
+        zgodna_bitowa = zgodna_bitowa && osiagalne.na_macierz() == matrix(wierzcholki).nad_przekatna() + matrix(wierzcholki).przekatna();
+        cout << "Zgodnosc z macierza gesta (&, |, ^, *, zliczanie, transpozycja)? " << (zgodna_bitowa ? "TAK" : "NIE") << endl << endl;
+        if (!zgodna_bitowa) throw logic_error("Macierz bitowa rozni sie od gestej");
+
+        // Test 54: Tryby akumulacji
+        cout << "=== TEST 54: TRYBY AKUMULACJI ===" << endl;
+        const int rozmiar_a = 40;
+        matrix duze_x(rozmiar_a), duze_y(rozmiar_a);
+        duze_x.losuj(200000, 21);
+        duze_y.losuj(200000, 22);
+        duze_y -= 100000;
+        duze_x.wstaw(3, 7, 2147483647);
+        duze_y.wstaw(7, 1, -2147483647 - 1);
+        matrix nasycony_wzor(rozmiar_a), modulo_wzor(rozmiar_a), modulo_duzy_wzor(rozmiar_a);
+        bool bylo_przepelnienie = false;
+        for (int i = 0; i < rozmiar_a; ++i)
+            for (int j = 0; j < rozmiar_a; ++j) {
+                long long suma = 0, suma_mod = 0, suma_duza = 0;
+                for (int l = 0; l < rozmiar_a; ++l) {
+                    long long x = duze_x.pokaz(i, l), y = duze_y.pokaz(l, j);
+                    suma += x * y;
+                    suma_mod = (suma_mod + (x % 1000003 + 1000003) % 1000003 * ((y % 1000003 + 1000003) % 1000003)) % 1000003;
+                    suma_duza = (suma_duza + (x % 2147483647 + 2147483647) % 2147483647 * ((y % 2147483647 + 2147483647) % 2147483647)) % 2147483647;
+                }
+                bylo_przepelnienie = bylo_przepelnienie || suma != static_cast<int>(suma);
+                nasycony_wzor.wstaw(i, j, static_cast<int>(std::clamp<long long>(suma, -2147483647LL - 1, 2147483647LL)));
+                modulo_wzor.wstaw(i, j, static_cast<int>(suma_mod));
+                modulo_duzy_wzor.wstaw(i, j, static_cast<int>(suma_duza));
+            }
+        bool zgodne_tryby = bylo_przepelnienie
+            && matrix::mnoz(duze_x, duze_y, tryb_akumulacji::nasycany) == nasycony_wzor
+            && matrix::mnoz(duze_x, duze_y, tryb_akumulacji::modulo, 1000003) == modulo_wzor
+            && matrix::mnoz(duze_x, duze_y, tryb_akumulacji::modulo, 2147483647) == modulo_duzy_wzor
+            && matrix::mnoz(duze_x, duze_y, tryb_akumulacji::zawijanie) == duze_x * duze_y;
+        bool sprawdzony = false;
+        try { matrix::mnoz(duze_x, duze_y, tryb_akumulacji::sprawdzany); }
+        catch (logic_error&) { sprawdzony = true; }
+        matrix male_x(rozmiar_a);
+        male_x.losuj(100, 23);
+        zgodne_tryby = zgodne_tryby && sprawdzony
+            && matrix::mnoz(male_x, male_x, tryb_akumulacji::sprawdzany) == male_x * male_x;
+        // Sumy częściowe przekraczają 2^63, ale wynik 2^32 - 2^32 = 0 mieści się w int
+        matrix skrajne_x(5), skrajne_y(5);
+        int wiersz_skrajny[5] = { -2147483647 - 1, -2147483647 - 1, -2147483647 - 1, -2147483647 - 1, 2 };
+        int kolumna_skrajna[5] = { -2147483647 - 1, -2147483647 - 1, 2147483647, 2147483647, -2147483647 - 1 };
+        skrajne_x.wiersz(0, wiersz_skrajny).wiersz(1, wiersz_skrajny);
+        skrajne_y.kolumna(0, kolumna_skrajna);
+        skrajne_x.wstaw(1, 4, 1); // wiersz 1: 2^32 - 2^31 = 2^31 > INT_MAX
+        matrix skrajny_iloczyn = matrix::mnoz(skrajne_x, skrajne_y, tryb_akumulacji::nasycany);
+        zgodne_tryby = zgodne_tryby && skrajny_iloczyn.pokaz(0, 0) == 0 && skrajny_iloczyn.pokaz(1, 0) == 2147483647;
+        // Sumy mieszczące się w 64 bitach liczy jądro blokowe: brzegi kafli, głębokość ponad KC i każdy poziom ISA
+        for (int rozmiar : { 1, 7, 37, 130, 300 }) {
+            matrix x(rozmiar), y(rozmiar), wzor(rozmiar);
+            x.losuj(200000, rozmiar);
+            y.losuj(200000, rozmiar + 1);
+            x -= 100000;
+            y -= 100000;
+            for (int i = 0; i < rozmiar; ++i)
+                for (int j = 0; j < rozmiar; ++j) {
+                    long long suma = 0;
+                    for (int l = 0; l < rozmiar; ++l) suma += static_cast<long long>(x.pokaz(i, l)) * y.pokaz(l, j);
+                    wzor.wstaw(i, j, static_cast<int>(std::clamp<long long>(suma, -2147483647LL - 1, 2147483647LL)));
+                }
+            for (simd::poziom_isa p : { simd::poziom_isa::skalarny, simd::poziom_isa::sse2, simd::poziom_isa::avx2, simd::poziom_isa::avx512 }) {
+                if (p > wykryty) continue;
+                simd::ustaw_poziom(p);
+                zgodne_tryby = zgodne_tryby && matrix::mnoz(x, y, tryb_akumulacji::nasycany) == wzor;
+            }
+            simd::ustaw_poziom(wykryty);
+        }
+        matrix::ustaw_akumulacje(tryb_akumulacji::modulo, 1000003);
+        zgodne_tryby = zgodne_tryby && duze_x * duze_y == modulo_wzor && matrix::modul_akumulacji() == 1000003
+            && duze_x.potega(3) == duze_x.potega(3, 1000003);
+        matrix::ustaw_akumulacje(tryb_akumulacji::nasycany);
+        zgodne_tryby = zgodne_tryby && duze_x * duze_y == nasycony_wzor;
+        matrix::ustaw_akumulacje(tryb_akumulacji::zawijanie);
+        bool odrzucony_modul = false;
+        try { matrix::ustaw_akumulacje(tryb_akumulacji::modulo, 0); }
+        catch (logic_error&) { odrzucony_modul = true; }
+        zgodne_tryby = zgodne_tryby && odrzucony_modul && matrix::akumulacja() == tryb_akumulacji::zawijanie;
+        cout << "Nasycanie, sprawdzanie i modulo zgodne z sumami 64-bitowymi? " << (zgodne_tryby ? "TAK" : "NIE") << endl << endl;
+        if (!zgodne_tryby) throw logic_error("Tryby akumulacji daja zly wynik");
+
+        // Test 55: Pakiety macierzy
+        cout << "=== TEST 55: PAKIETY MACIERZY ===" << endl;
+        bool zgodny_pakiet = true;
+        for (int rozmiar_p : { 1, 4, 7, 32 }) {
+            const int liczba_p = 37; // dwie pełne grupy i niepełna
+            std::vector<matrix> lewe, prawe;
+            for (int m = 0; m < liczba_p; ++m) {
+                lewe.push_back(matrix(rozmiar_p).losuj(1000, 300 + m));
+                prawe.push_back(matrix(rozmiar_p).losuj(1000, 400 + m));
+                prawe.back() -= 500;
+            }
+            pakiet_macierzy pakiet_l(lewe), pakiet_p(prawe);
+            std::vector<matrix> iloczyny_p = (pakiet_l * pakiet_p).na_macierze();
+            std::vector<matrix> sumy_p = (pakiet_l + pakiet_p).na_macierze();
+            pakiet_macierzy przeksztalcony = pakiet_l;
+            przeksztalcony += 3;
+            przeksztalcony *= -2;
+            przeksztalcony -= 1;
+            przeksztalcony.odwroc();
+            std::vector<matrix> przeksztalcone = przeksztalcony.na_macierze();
+            for (int m = 0; m < liczba_p; ++m) {
+                matrix oczekiwana = lewe[m];
+                ((oczekiwana += 3) *= -2) -= 1;
+                zgodny_pakiet = zgodny_pakiet && iloczyny_p[m] == lewe[m] * prawe[m]
+                    && sumy_p[m] == lewe[m] + prawe[m] && przeksztalcone[m] == oczekiwana.odwroc();
+            }
+            zgodny_pakiet = zgodny_pakiet && pakiet_l.pobierz(36) == lewe[36] && pakiet_l.pokaz(20, 0, 0) == lewe[20].pokaz(0, 0)
+                && pakiet_l == pakiet_macierzy(lewe) && !(pakiet_l == pakiet_p) && (pakiet_l + 0) == pakiet_l;
+        }
+        pakiet_macierzy duzy_pakiet(4, 100000);
+        for (int m = 0; m < 100000; m += 9999) duzy_pakiet.ustaw(m, matrix(4).przekatna() * (m % 7 + 1));
+        pakiet_macierzy kwadraty = duzy_pakiet * duzy_pakiet;
+        for (int m = 0; m < 100000; m += 9999)
+            zgodny_pakiet = zgodny_pakiet && kwadraty.pobierz(m) == matrix(4).przekatna() * ((m % 7 + 1) * (m % 7 + 1));
+        zgodny_pakiet = zgodny_pakiet && kwadraty.pokaz(1, 2, 2) == 0;
+        bool odrzucony_pakiet = false;
+        try { pakiet_macierzy(3, 2) * pakiet_macierzy(3, 3); }
+        catch (logic_error&) { odrzucony_pakiet = true; }
+        cout << "Iloczyny, sumy, skalary i transpozycja pakietow zgodne z matrix? " << (zgodny_pakiet && odrzucony_pakiet ? "TAK" : "NIE") << endl << endl;
+        if (!zgodny_pakiet || !odrzucony_pakiet) throw logic_error("Pakiet macierzy rozni sie od pojedynczych macierzy");
+
+        // Test 56: Porównania wektorowe i skrót zawartości
+        cout << "=== TEST 56: POROWNANIA WEKTOROWE I SKROT ===" << endl;
+        bool zgodne_porownania = true, zgodne_skroty = true;
+        for (int rozmiar : { 1, 3, 4, 5, 16, 33 }) {
+            matrix x(rozmiar);
+            x.losuj(1000, rozmiar);
+            int ostatni = x.pokaz(rozmiar - 1, rozmiar - 1);
+            matrix mniejsza = x - 1, wieksza = x + 1;
+            // Relację psuje tylko pierwszy albo tylko ostatni element
+            matrix prawie_pierwszy = wieksza, prawie_ostatni = wieksza;
+            prawie_pierwszy.wstaw(0, 0, x.pokaz(0, 0));
+            prawie_ostatni.wstaw(rozmiar - 1, rozmiar - 1, ostatni);
+            matrix inna_pierwszy = x, inna_ostatni = x;
+            inna_pierwszy.wstaw(0, 0, x.pokaz(0, 0) + 1);
+            inna_ostatni.wstaw(rozmiar - 1, rozmiar - 1, ostatni - 1);
+            std::uint64_t wzorcowy = 0;
+            for (simd::poziom_isa p : { simd::poziom_isa::skalarny, simd::poziom_isa::sse2, simd::poziom_isa::avx2, simd::poziom_isa::avx512 }) {
+                if (p > wykryty) continue;
+                simd::ustaw_poziom(p);
+                matrix kopia = x + 0;
+                zgodne_porownania = zgodne_porownania && x == kopia && !(x == inna_pierwszy) && !(x == inna_ostatni)
+                    && x < wieksza && mniejsza < x && wieksza > x && x > mniejsza && !(x < x) && !(x > x)
+                    && !(x < prawie_pierwszy) && !(x < prawie_ostatni) && !(prawie_pierwszy > x) && !(prawie_ostatni > x);
+                if (wzorcowy == 0) wzorcowy = kopia.skrot();
+                zgodne_skroty = zgodne_skroty && kopia.skrot() == wzorcowy && (x + 0).skrot() != inna_ostatni.skrot();
+            }
+            simd::ustaw_poziom(wykryty);
+
+            // Skrót zapamiętany przed zmianą nie może przetrwać modyfikacji
+            matrix y = x;
+            std::uint64_t przed = y.skrot();
+            y += 1;
+            zgodne_skroty = zgodne_skroty && y.skrot() != przed && y.skrot() == wieksza.skrot() && y == wieksza;
+            y[0][0] = x.pokaz(0, 0);
+            zgodne_skroty = zgodne_skroty && y.skrot() == prawie_pierwszy.skrot();
+            y = x;
+            zgodne_skroty = zgodne_skroty && y.skrot() == przed;
+            matrix z = std::move(y);
+            zgodne_skroty = zgodne_skroty && z.skrot() == przed && y.skrot() != przed;
+        }
+        matrix wiersze(16);
+        wiersze.losuj(1000, 56);
+        matrix zamienione = wiersze;
+        for (int j = 0; j < 16; ++j) std::swap(zamienione[0][j], zamienione[1][j]);
+        zgodne_skroty = zgodne_skroty && wiersze.skrot() != zamienione.skrot() && !(wiersze == zamienione)
+            && matrix(3).skrot() != matrix(4).skrot();
+        // Zmiany znoszące się przy liniowym łączeniu pasów i zamiany bliskich pozycji
+        matrix liniowa(8);
+        liniowa.losuj(1000, 24);
+        liniowa.data()[0] = liniowa.data()[16] = static_cast<int>(0x85A308D3u);
+        matrix znoszaca = liniowa;
+        znoszaca.data()[1] += 1;
+        znoszaca.data()[17] -= 33;
+        zgodne_skroty = zgodne_skroty && liniowa.skrot() != znoszaca.skrot();
+        std::unordered_set<std::uint64_t> skroty_zamian = { liniowa.skrot() };
+        int zamiany = 1;
+        for (int e = 0; e + 16 < 64; ++e) {
+            for (int odstep : { 1, 2, 16 }) {
+                matrix zamieniona = liniowa;
+                int* d = zamieniona.data();
+                if (d[e] == d[e + odstep]) continue;
+                std::swap(d[e], d[e + odstep]);
+                skroty_zamian.insert(zamieniona.skrot());
+                ++zamiany;
+            }
+        }
+        zgodne_skroty = zgodne_skroty && static_cast<int>(skroty_zamian.size()) == zamiany;
+        std::unordered_set<matrix> unikalne = { wiersze, zamienione, wiersze + 0, zamienione.odwrocona().odwroc(), matrix(16) };
+        zgodne_skroty = zgodne_skroty && unikalne.size() == 3 && unikalne.count(wiersze) == 1;
+        // Zapis przez wskaźnik pobrany przed obliczeniem skrótu
+        matrix przez_wskaznik = zamienione;
+        int* wskaznik = przez_wskaznik.data();
+        std::uint64_t skrot_przed_zapisem = przez_wskaznik.skrot();
+        std::copy(wiersze.begin(), wiersze.end(), wskaznik);
+        zgodne_skroty = zgodne_skroty && skrot_przed_zapisem == zamienione.skrot() && przez_wskaznik == wiersze
+            && przez_wskaznik.skrot() == wiersze.skrot() && unikalne.count(przez_wskaznik) == 1;
+        przez_wskaznik = zamienione;
+        wskaznik[0] = zamienione.pokaz(0, 0) + 1;
+        zgodne_skroty = zgodne_skroty && !(przez_wskaznik == zamienione) && unikalne.count(przez_wskaznik) == 0;
+        cout << "Porownania ==, <, > zgodne na kazdym poziomie ISA? " << (zgodne_porownania ? "TAK" : "NIE") << endl;
+        cout << "Skroty stale miedzy ISA i uniewazniane po zmianie? " << (zgodne_skroty ? "TAK" : "NIE") << endl << endl;
+        if (!zgodne_porownania || !zgodne_skroty) throw logic_error("Porownanie lub skrot macierzy niepoprawne");
+
+        // Test 57: Pamięć iloczynów
+        cout << "=== TEST 57: PAMIEC ILOCZYNOW ===" << endl;
+        matrix przejscia(8), stan_p(8);
+        int wagi_przejsc[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        przejscia.diagonalna_k(1, wagi_przejsc).diagonalna_k(-1, wagi_przejsc);
+        stan_p.losuj(50, 57);
+        matrix oczekiwany = przejscia * stan_p, oczekiwana_potega = przejscia.potega(6), oczekiwana_mod = przejscia.potega(6, 11);
+        // Wpis iloczynu obejmuje wynik i kopie obu czynników, wpis potęgi wynik i podstawę
+        constexpr std::size_t ILOCZYN_8 = 3 * 8 * 8 * sizeof(int), POTEGA_8 = 2 * 8 * 8 * sizeof(int);
+        pamiec_iloczynow::ustaw_limit(ILOCZYN_8 + 2 * POTEGA_8);
+        pamiec_iloczynow::zeruj_statystyki();
+        bool zgodna_pamiec = przejscia * stan_p == oczekiwany && przejscia * stan_p == oczekiwany
+            && przejscia.potega(6) == oczekiwana_potega && przejscia.potega(6) == oczekiwana_potega
+            && przejscia.potega(6, 11) == oczekiwana_mod;
+        pamiec_iloczynow::statystyki st_il = pamiec_iloczynow::pobierz_statystyki();
+        zgodna_pamiec = zgodna_pamiec && st_il.trafienia == 2 && st_il.chybienia == 3 && st_il.wpisy == 3 && st_il.bajty == ILOCZYN_8 + 2 * POTEGA_8;
+
+        // Zmiana argumentu albo trybu akumulacji to inny klucz
+        stan_p += 1;
+        zgodna_pamiec = zgodna_pamiec && przejscia * stan_p == oczekiwany + matrix::mnoz(przejscia, matrix(8) + 1, algorytm_mnozenia::naiwny);
+        matrix::ustaw_akumulacje(tryb_akumulacji::modulo, 11);
+        zgodna_pamiec = zgodna_pamiec && przejscia.potega(6) == oczekiwana_mod && przejscia * stan_p == matrix::mnoz(przejscia, stan_p, tryb_akumulacji::modulo, 11);
+        matrix::ustaw_akumulacje(tryb_akumulacji::zawijanie);
+
+        // Zostały dwa wpisy trybu modulo (potęga trafiła w wynik potega(6, 11)); potęga 6 została usunięta
+        st_il = pamiec_iloczynow::pobierz_statystyki();
+        zgodna_pamiec = zgodna_pamiec && st_il.wpisy == 2 && st_il.bajty == ILOCZYN_8 + POTEGA_8 && st_il.usuniecia == 3;
+        pamiec_iloczynow::zeruj_statystyki();
+        zgodna_pamiec = zgodna_pamiec && przejscia.potega(6) == oczekiwana_potega && pamiec_iloczynow::pobierz_statystyki().chybienia == 1;
+
+        // Kolizja klucza kończy się chybieniem, a zapis przez wydany wskaźnik zmienia klucz
+        pamiec_iloczynow::zeruj_statystyki();
+        matrix inny(8);
+        inny.losuj(50, 58);
+        pamiec_iloczynow::klucz podrobiony{ pamiec_iloczynow::dzialanie::iloczyn, tryb_akumulacji::zawijanie, 0, 8, przejscia.skrot(), stan_p.skrot() };
+        pamiec_iloczynow::zapamietaj(podrobiony, inny, &stan_p, matrix::mnoz(inny, stan_p, algorytm_mnozenia::naiwny));
+        zgodna_pamiec = zgodna_pamiec && przejscia * stan_p == matrix::mnoz(przejscia, stan_p, algorytm_mnozenia::naiwny);
+        matrix zmieniana = stan_p;
+        int* surowe = zmieniana.data();
+        zgodna_pamiec = zgodna_pamiec && przejscia * zmieniana == przejscia * stan_p;
+        surowe[0] += 1;
+        zgodna_pamiec = zgodna_pamiec && przejscia * zmieniana == matrix::mnoz(przejscia, zmieniana, algorytm_mnozenia::naiwny);
+        st_il = pamiec_iloczynow::pobierz_statystyki();
+        zgodna_pamiec = zgodna_pamiec && st_il.niezgodne == 1 && st_il.trafienia == 2;
+
+        // Równoległe odczyty tego samego iloczynu
+        pamiec_iloczynow::ustaw_limit(std::size_t(1) << 20);
+        pamiec_iloczynow::wyczysc();
+        pamiec_iloczynow::zeruj_statystyki();
+        matrix duza_a(64), duza_b(64);
+        duza_a.losuj(9, 1);
+        duza_b.losuj(9, 2);
+        matrix duzy_iloczyn = matrix::mnoz(duza_a, duza_b, algorytm_mnozenia::naiwny);
+        bool zgodne_watki[4] = {};
+        std::vector<std::thread> watki_pamieci;
+        for (int w = 0; w < 4; ++w)
+            watki_pamieci.emplace_back([&, w] {
+                bool zgodne = true;
+                for (int powtorzenie = 0; powtorzenie < 25; ++powtorzenie) zgodne = zgodne && duza_a * duza_b == duzy_iloczyn;
+                zgodne_watki[w] = zgodne;
+            });
+        for (std::thread& t : watki_pamieci) t.join();
+        st_il = pamiec_iloczynow::pobierz_statystyki();
+        zgodna_pamiec = zgodna_pamiec && std::all_of(zgodne_watki, zgodne_watki + 4, [](bool z) { return z; })
+            && st_il.trafienia + st_il.chybienia == 100 && st_il.chybienia <= 4 && st_il.wpisy == 1;
+        cout << "Pamiec iloczynow: " << st_il << endl;
+
+        pamiec_iloczynow::ustaw_limit(0);
+        zgodna_pamiec = zgodna_pamiec && !pamiec_iloczynow::wlaczona() && pamiec_iloczynow::pobierz_statystyki().wpisy == 0
+            && przejscia * stan_p == matrix::mnoz(przejscia, stan_p, algorytm_mnozenia::naiwny);
+        cout << "Wyniki z pamieci zgodne, LRU w limicie i statystyki poprawne? " << (zgodna_pamiec ? "TAK" : "NIE") << endl << endl;
+        if (!zgodna_pamiec) throw logic_error("Pamiec iloczynow zwraca zly wynik lub przekracza limit");
+
         cout << "========== WSZYSTKIE TESTY ZAKONCZONE POMYSLNIE! ==========" << endl;
 
     }
@@ -4,34 +4,168 @@
  */
 
 #include "matrix.h"
+#include "mnozenie.h"
+#include "pamiec_iloczynow.h"
+#include "plik.h"
+#include "pomiary.h"
+#include "poza_pamiecia.h"
+#include "simd.h"
+#include "transpozycja.h"
+#include "watki.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
 
+namespace {
+    /// Algorytm używany przez operator*
+    std::atomic<algorytm_mnozenia> domyslny_algorytm{ algorytm_mnozenia::rownolegly };
+    /// Próg przejścia algorytmu Strassena na mnożenie blokowe
+    std::atomic<int> prog_strassena_{ 512 };
+
+    /**
+     * @brief Liczy C = A * B na buforach n×n wybranym algorytmem
+     */
+    void mnoz_bufory(const int* a, const int* b, int* c, int n, algorytm_mnozenia alg) {
+        switch (alg) {
+        case algorytm_mnozenia::naiwny:
+            mnozenie::naiwne(a, b, c, n);
+            break;
+        case algorytm_mnozenia::blokowy:
+            mnozenie::blokowe(a, b, c, n);
+            break;
+        case algorytm_mnozenia::rownolegly:
+            mnozenie::blokowe_rownolegle(a, b, c, n);
+            break;
+        case algorytm_mnozenia::strassen:
+            mnozenie::strassen(a, b, c, n, matrix::prog_strassena());
+            break;
+        }
+    }
+
+    /// Tryb akumulacji używany przez operator* wraz z modułem trybu modulo
+    struct ustawienia_akumulacji {
+        tryb_akumulacji tryb;
+        int modul;
+    };
+    std::atomic<ustawienia_akumulacji> domyslna_akumulacja{ { tryb_akumulacji::zawijanie, 0 } };
+
+    /**
+     * @brief Liczy C = A * B na buforach n×n w wybranym trybie akumulacji
+     * @details W trybie modulo elementy A i B muszą już należeć do [0, modul).
+     * @throw std::logic_error W trybie sprawdzanym, gdy element wyniku nie mieści się w int
+     */
+    void mnoz_w_trybie(const int* a, const int* b, int* c, int n, tryb_akumulacji tryb, int modul) {
+        switch (tryb) {
+        case tryb_akumulacji::zawijanie:
+            mnoz_bufory(a, b, c, n, matrix::algorytm());
+            break;
+        case tryb_akumulacji::sprawdzany:
+            if (!mnozenie::nasycone(a, b, c, n))
+                throw std::logic_error("Wynik mnozenia nie miesci sie w int");
+            break;
+        case tryb_akumulacji::nasycany:
+            mnozenie::nasycone(a, b, c, n);
+            break;
+        case tryb_akumulacji::modulo:
+            mnozenie::modulo(a, b, c, n, modul);
+            break;
+        }
+    }
+
+    /**
+     * @brief Sprowadza elementy macierzy do zakresu [0, modul)
+     */
+    void redukuj(matrix& m, int modul) {
+        for (int& x : m) {
+            x %= modul;
+            if (x < 0) x += modul;
+        }
+    }
+
+    /**
+     * @brief Zwraca wynik z pamięci iloczynów albo liczy go i zapamiętuje
+     * @param rodzaj Działanie
+     * @param tryb Tryb akumulacji
+     * @param modul Moduł (używany tylko w trybie modulo)
+     * @param a Lewy czynnik albo podstawa potęgi
+     * @param b Prawy czynnik albo nullptr dla potęgi
+     * @param prawy Skrót prawego czynnika albo wykładnik potęgi
+     * @param licz Obliczenie wyniku przy chybieniu
+     */
+    matrix z_pamieci(pamiec_iloczynow::dzialanie rodzaj, tryb_akumulacji tryb, int modul, const matrix& a,
+        const matrix* b, std::uint64_t prawy, const std::function<matrix()>& licz) {
+        pamiec_iloczynow::klucz k{ rodzaj, tryb, tryb == tryb_akumulacji::modulo ? modul : 0, a.getSize(), a.skrot(), prawy };
+        if (std::shared_ptr<const matrix> wynik = pamiec_iloczynow::znajdz(k, a, b)) return *wynik;
+        matrix wynik = licz();
+        pamiec_iloczynow::zapamietaj(k, a, b, wynik);
+        return wynik;
+    }
+
+    /**
+     * @brief Sprawdza, czy wszystkie elementy macierzy należą do [0, modul)
+     */
+    bool w_zakresie(const matrix& m, int modul) {
+        return std::all_of(m.begin(), m.end(), [modul](int x) { return x >= 0 && x < modul; });
+    }
+}
+
  // ==================== Konstruktory i destruktor ====================
 
  /**
   * @brief Konstruktor domyślny - tworzy pustą macierz o rozmiarze 0x0
   */
-matrix::matrix(void) : n(0), allocated_n(0), macierz_ptr(nullptr) {}
+matrix::matrix(void) : n(0), allocated_n(0) {}
 
 /**
  * @brief Konstruktor parametryczny - tworzy macierz n×n wypełnioną zerami
  * @param n Rozmiar macierzy kwadratowej
  */
 matrix::matrix(int n) : n(n), allocated_n(n) {
-    macierz_ptr = std::make_unique<int[]>(n * n);
+    MATRIX_POMIAR(konstrukcja, static_cast<std::size_t>(n) * n);
+    macierz_ptr = pamiec::przydziel(static_cast<std::size_t>(n) * n);
     for (int i = 0; i < n * n; ++i) {
         macierz_ptr[i] = 0;
     }
 }
 
+/**
+ * @brief Konstruktor tworzący macierz n×n bez inicjalizacji elementów
+ * @details Używany przez operatory, które nadpisują cały wynik
+ * @param n Rozmiar macierzy kwadratowej
+ */
+matrix::matrix(int n, bez_zerowania_t) : n(n), allocated_n(n),
+    macierz_ptr(pamiec::przydziel(static_cast<std::size_t>(n) * n)) {}
+
+/**
+ * @brief Zapewnia bufor na rozmiar×rozmiar elementów, bez zerowania nowej pamięci
+ * @param rozmiar Wymagany rozmiar macierzy
+ */
+void matrix::zarezerwuj(int rozmiar) {
+    if (allocated_n >= rozmiar) return;
+    macierz_ptr = pamiec::przydziel(static_cast<std::size_t>(rozmiar) * rozmiar);
+    allocated_n = rozmiar;
+    udostepniona = false;
+}
+
+/**
+ * @brief Konstruktor przejmujący gotowy bufor danych
+ * @param n Rozmiar macierzy kwadratowej
+ * @param dane Bufor z n*n elementami
+ */
+matrix::matrix(int n, pamiec::bufor dane) : n(n), allocated_n(n), macierz_ptr(std::move(dane)) {}
+
 /**
  * @brief Konstruktor z tablicą - tworzy macierz n×n wypełnioną wartościami z tablicy
  * @param n Rozmiar macierzy kwadratowej
  * @param t Wskaźnik do tablicy z danymi (wymaga n*n elementów)
  */
 matrix::matrix(int n, int* t) : n(n), allocated_n(n) {
-    macierz_ptr = std::make_unique<int[]>(n * n);
+    MATRIX_POMIAR(konstrukcja, static_cast<std::size_t>(n) * n);
+    macierz_ptr = pamiec::przydziel(static_cast<std::size_t>(n) * n);
     for (int i = 0; i < n * n; ++i) {
         macierz_ptr[i] = t[i];
     }
@@ -41,15 +175,67 @@ matrix::matrix(int n, int* t) : n(n), allocated_n(n) {
  * @brief Konstruktor kopiujący - tworzy głęboką kopię macierzy
  * @param m Macierz źródłowa do skopiowania
  */
-matrix::matrix(const matrix& m) : n(m.n), allocated_n(m.allocated_n) {
-    macierz_ptr = std::make_unique<int[]>(n * n);
+matrix::matrix(const matrix& m) : n(m.n), allocated_n(m.n), zapamietany_skrot(m.zapamietany_skrot.load(std::memory_order_relaxed)) {
+    MATRIX_POMIAR(kopiowanie, static_cast<std::size_t>(m.n) * m.n);
+    macierz_ptr = pamiec::przydziel(static_cast<std::size_t>(n) * n);
     for (int i = 0; i < n * n; ++i) {
         macierz_ptr[i] = m.macierz_ptr[i];
     }
 }
 
 /**
- * @brief Destruktor - zwalnia automatycznie pamięć dzięki unique_ptr
+ * @brief Konstruktor przenoszący - przejmuje pamięć, źródło staje się macierzą 0×0
+ * @param other Macierz do przeniesienia
+ */
+matrix::matrix(matrix&& other) noexcept
+    : n(other.n), allocated_n(other.allocated_n), macierz_ptr(std::move(other.macierz_ptr)),
+    zapamietany_skrot(other.zapamietany_skrot.load(std::memory_order_relaxed)), udostepniona(other.udostepniona) {
+    other.n = 0;
+    other.allocated_n = 0;
+    other.zmieniona();
+    other.udostepniona = false;
+}
+
+/**
+ * @brief Przypisanie kopiujące
+ * @details Jeżeli zaalokowana pamięć jest za mała, alokowana jest nowa
+ * (bez zerowania, bo zostanie nadpisana); w przeciwnym razie dane
+ * kopiowane są do istniejącego bufora. Skrót źródła jest przejmowany
+ * tylko wtedy, gdy do bufora nie wydano wcześniej wskaźnika (zob. skrot()).
+ * @param m Macierz źródłowa do skopiowania
+ * @return Referencja do bieżącej macierzy
+ */
+matrix& matrix::operator=(const matrix& m) {
+    MATRIX_POMIAR(kopiowanie, static_cast<std::size_t>(m.n) * m.n);
+    if (this == &m) return *this;
+    zarezerwuj(m.n);
+    n = m.n;
+    std::copy(m.macierz_ptr.get(), m.macierz_ptr.get() + static_cast<std::size_t>(n) * n, macierz_ptr.get());
+    zapamietany_skrot.store(udostepniona ? 0 : m.zapamietany_skrot.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
+/**
+ * @brief Przypisanie przenoszące - przejmuje pamięć źródła bez kopiowania
+ * @param m Macierz do przeniesienia
+ * @return Referencja do bieżącej macierzy
+ */
+matrix& matrix::operator=(matrix&& m) noexcept {
+    if (this == &m) return *this;
+    n = m.n;
+    allocated_n = m.allocated_n;
+    macierz_ptr = std::move(m.macierz_ptr);
+    zapamietany_skrot.store(m.zapamietany_skrot.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    udostepniona = m.udostepniona;
+    m.n = 0;
+    m.allocated_n = 0;
+    m.zmieniona();
+    m.udostepniona = false;
+    return *this;
+}
+
+/**
+ * @brief Destruktor - zwalnia automatycznie pamięć dzięki unique_ptr (bufor wraca do puli)
  */
 matrix::~matrix(void) {}
 
@@ -65,6 +251,7 @@ matrix::~matrix(void) {}
 int& matrix::at(int x, int y) {
     if (x >= n || y >= n || x < 0 || y < 0)
         throw std::logic_error("Zle wspolrzedne macierzy");
+    udostepnij();
     return macierz_ptr[x * n + y];
 }
 
@@ -78,20 +265,68 @@ const int& matrix::at(int x, int y) const {
     return macierz_ptr[x * n + y];
 }
 
+/**
+ * @brief Wstawia wartość do określonej pozycji w macierzy
+ * @details W odróżnieniu od at() nie wydaje referencji, więc nie wyłącza
+ * zapamiętywania skrótu.
+ * @param x Indeks wiersza
+ * @param y Indeks kolumny
+ * @param val Wartość do wstawienia
+ * @throw std::logic_error Jeśli współrzędne są poza zakresem
+ */
+void matrix::wstaw(int x, int y, int val) {
+    if (x >= n || y >= n || x < 0 || y < 0)
+        throw std::logic_error("Zle wspolrzedne macierzy");
+    wiersz_do_zapisu(x)[y] = val;
+}
+
 // ==================== Metody losowania i wypełniania ====================
 
+namespace {
+
+    constexpr std::uint64_t ZLOTY_PODZIAL = 0x9E3779B97F4A7C15ull; ///< Przyrost licznika SplitMix64
+    constexpr std::size_t PACZKA_LOSOWANIA = std::size_t(1) << 16;   ///< Elementy losowane przez jedno zadanie puli
+
+    /**
+     * @brief Funkcja mieszająca SplitMix64
+     * @details Zastosowana do licznika ziarno + i * ZLOTY_PODZIAL daje ciąg
+     * SplitMix64, w którym i-ty element można policzyć niezależnie od innych.
+     */
+    inline std::uint64_t splitmix64(std::uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Zwraca nowe ziarno dla losuj() bez podanego ziarna
+     * @details Licznik inicjalizowany jest raz z std::random_device; kolejne
+     * wywołania (także z różnych wątków) dostają różne ziarna.
+     */
+    std::uint64_t nowe_ziarno() {
+        static std::atomic<std::uint64_t> licznik{ (static_cast<std::uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}() };
+        return splitmix64(licznik.fetch_add(ZLOTY_PODZIAL, std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Wypełnia fragment [od, do_) wartościami z zakresu [0, zakres - 1]
+     * @details Element i zależy wyłącznie od ziarna i i, więc podział na
+     * fragmenty nie wpływa na wynik.
+     */
+    void losuj_fragment(int* dane, std::size_t od, std::size_t do_, std::uint64_t ziarno, std::uint64_t zakres) {
+        for (std::size_t i = od; i < do_; ++i) {
+            std::uint64_t h = splitmix64(ziarno + (i + 1) * ZLOTY_PODZIAL);
+            dane[i] = static_cast<int>(((h >> 32) * zakres) >> 32);
+        }
+    }
+}
+
 /**
  * @brief Wypełnia macierz losowymi liczbami z zakresu [0, 9]
  * @return Referencja do bieżącej macierzy (umożliwia łańcuchowanie wywołań)
  */
 matrix& matrix::losuj(void) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 9);
-    for (int i = 0; i < n * n; ++i) {
-        macierz_ptr[i] = dis(gen);
-    }
-    return *this;
+    return losuj(9, nowe_ziarno());
 }
 
 /**
@@ -100,12 +335,37 @@ matrix& matrix::losuj(void) {
  * @return Referencja do bieżącej macierzy
  */
 matrix& matrix::losuj(int x) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, x);
-    for (int i = 0; i < n * n; ++i) {
-        macierz_ptr[i] = dis(gen);
+    return losuj(x, nowe_ziarno());
+}
+
+/**
+ * @brief Wypełnia macierz powtarzalnymi liczbami losowymi z zakresu [0, x]
+ * @details Element o indeksie i (wierszami) to SplitMix64 od licznika
+ * ziarno + (i + 1) * 0x9E3779B97F4A7C15 przeskalowany do [0, x]. Paczki
+ * elementów losowane są równolegle w globalnej puli wątków; wynik zależy
+ * tylko od ziarna i rozmiaru, a nie od liczby wątków.
+ * @param x Górna granica zakresu losowania
+ * @param ziarno Ziarno generatora
+ * @return Referencja do bieżącej macierzy
+ * @throw std::logic_error Gdy x < 0
+ */
+matrix& matrix::losuj(int x, std::uint64_t ziarno) {
+    MATRIX_POMIAR(losowanie, static_cast<std::size_t>(n) * n);
+    zmieniona();
+    if (x < 0)
+        throw std::logic_error("Gorna granica losowania musi byc nieujemna");
+    std::size_t ile = static_cast<std::size_t>(n) * n;
+    std::uint64_t zakres = static_cast<std::uint64_t>(x) + 1;
+    int* dane = macierz_ptr.get();
+    int paczki = static_cast<int>((ile + PACZKA_LOSOWANIA - 1) / PACZKA_LOSOWANIA);
+    if (paczki <= 1) {
+        losuj_fragment(dane, 0, ile, ziarno, zakres);
+        return *this;
     }
+    watki::globalna()->rownolegle_dla(paczki, [&](int p) {
+        std::size_t od = static_cast<std::size_t>(p) * PACZKA_LOSOWANIA;
+        losuj_fragment(dane, od, std::min(ile, od + PACZKA_LOSOWANIA), ziarno, zakres);
+    });
     return *this;
 }
 
@@ -115,31 +375,149 @@ matrix& matrix::losuj(int x) {
  * @return Referencja do bieżącej macierzy
  */
 matrix& matrix::szachownica(void) {
+    MATRIX_POMIAR(wypelnianie, static_cast<std::size_t>(n) * n);
     for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            at(i, j) = ((i + j) % 2 != 0) ? 1 : 0;
-        }
+        std::span<int> r = wiersz_do_zapisu(i);
+        for (int j = 0; j < n; ++j) r[j] = (i + j) & 1;
     }
     return *this;
 }
 
-// ==================== Operator wyjścia ====================
+// ==================== Operatory wejścia i wyjścia ====================
+
+namespace {
+
+    constexpr std::size_t BUFOR_TEKSTU = 1 << 16; ///< Rozmiar bufora zapisu tekstowego
+    constexpr std::size_t MAKS_ZNAKOW_LICZBY = 12; ///< "-2147483648 " - najdłuższy zapis elementu
+
+    /**
+     * @brief Parsuje liczby oddzielone spacjami z jednego wiersza tekstu
+     * @param linia Wiersz tekstu
+     * @param wyjscie Miejsce na wartości (nullptr - tylko zliczanie)
+     * @param limit Maksymalna liczba wartości zapisywanych do wyjscie
+     * @return Liczba wartości lub -1 przy błędnych danych
+     */
+    long parsuj_wiersz(const std::string& linia, int* wyjscie, long limit) {
+        const char* p = linia.data();
+        const char* koniec = p + linia.size();
+        long ile = 0;
+        while (true) {
+            while (p != koniec && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+            if (p == koniec) return ile;
+            int wartosc;
+            std::from_chars_result r = std::from_chars(p, koniec, wartosc);
+            if (r.ec != std::errc()) return -1;
+            if (wyjscie) {
+                if (ile >= limit) return -1;
+                wyjscie[ile] = wartosc;
+            }
+            ++ile;
+            p = r.ptr;
+        }
+    }
+}
 
 /**
  * @brief Operator wyjścia - wypisuje macierz do strumienia
- * @details Każdy wiersz w osobnej linii, elementy oddzielone spacjami
+ * @details Każdy wiersz w osobnej linii, elementy oddzielone spacjami.
+ * Liczby formatowane są przez std::to_chars do lokalnego bufora, który
+ * trafia do strumienia dużymi blokami.
  * @param o Strumień wyjściowy
  * @param m Macierz do wypisania
  * @return Referencja do strumienia (umożliwia łańcuchowanie)
  */
 std::ostream& operator<<(std::ostream& o, const matrix& m) {
+    MATRIX_POMIAR(wejscie_wyjscie, static_cast<std::size_t>(m.n) * m.n);
+    std::unique_ptr<char[]> bufor(new char[BUFOR_TEKSTU]);
+    char* koniec_bufora = bufor.get() + BUFOR_TEKSTU;
+    char* p = bufor.get();
+    const int* dane = m.macierz_ptr.get();
     for (int i = 0; i < m.n; ++i) {
-        for (int j = 0; j < m.n; ++j) o << m.at(i, j) << " ";
-        o << "\n";
+        const int* wiersz = dane + static_cast<std::size_t>(i) * m.n;
+        for (int j = 0; j < m.n; ++j) {
+            if (static_cast<std::size_t>(koniec_bufora - p) < MAKS_ZNAKOW_LICZBY + 1) {
+                o.write(bufor.get(), p - bufor.get());
+                p = bufor.get();
+            }
+            p = std::to_chars(p, koniec_bufora, wiersz[j]).ptr;
+            *p++ = ' ';
+        }
+        *p++ = '\n';
     }
+    o.write(bufor.get(), p - bufor.get());
     return o;
 }
 
+/**
+ * @brief Operator wejścia - wczytuje macierz w formacie operatora wyjścia
+ * @details Puste i złożone z samych białych znaków linie przed macierzą są
+ * pomijane (np. separator `o << a << std::endl << b`). Pierwszy wiersz
+ * wyznacza n; kolejne n-1 wierszy musi mieć po n wartości. Liczby
+ * parsowane są przez std::from_chars.
+ * @param i Strumień wejściowy
+ * @param m Macierz docelowa
+ * @return Referencja do strumienia
+ */
+std::istream& operator>>(std::istream& i, matrix& m) {
+    MATRIX_POMIAR(wejscie_wyjscie, 0);
+    std::string linia;
+    do {
+        if (!std::getline(i, linia)) return i;
+    } while (linia.find_first_not_of(" \t\r\v\f") == std::string::npos);
+    long n = parsuj_wiersz(linia, nullptr, 0);
+    if (n <= 0) {
+        i.setstate(std::ios::failbit);
+        return i;
+    }
+
+    matrix wynik(static_cast<int>(n), matrix::bez_zerowania_t{});
+    int* dane = wynik.macierz_ptr.get();
+    parsuj_wiersz(linia, dane, n);
+    for (long w = 1; w < n; ++w) {
+        if (!std::getline(i, linia) || parsuj_wiersz(linia, dane + w * n, n) != n) {
+            i.setstate(std::ios::failbit);
+            return i;
+        }
+    }
+    m = std::move(wynik);
+    return i;
+}
+
+// ==================== Pliki binarne ====================
+
+/**
+ * @brief Zapisuje macierz do pliku w formacie binarnym
+ * @param sciezka Ścieżka pliku (nadpisywanego)
+ */
+void matrix::zapisz(const std::string& sciezka) const {
+    MATRIX_POMIAR(wejscie_wyjscie, static_cast<std::size_t>(n) * n);
+    plik::zapisz(sciezka, macierz_ptr.get(), n);
+}
+
+/**
+ * @brief Wczytuje macierz z pliku binarnego (mapowanie pamięci, bez kopiowania)
+ * @param sciezka Ścieżka pliku
+ * @return Wczytana macierz
+ */
+matrix matrix::wczytaj(const std::string& sciezka) {
+    MATRIX_POMIAR(wejscie_wyjscie, 0);
+    int n = 0;
+    pamiec::bufor dane = plik::wczytaj(sciezka, n);
+    return matrix(n, std::move(dane));
+}
+
+/**
+ * @brief Mnoży macierze zapisane w plikach binarnych kafel po kaflu
+ * @param plik_a Ścieżka pliku macierzy A
+ * @param plik_b Ścieżka pliku macierzy B
+ * @param plik_c Ścieżka pliku wynikowego
+ * @param limit_bajtow Ograniczenie pamięci na bufory kafli
+ */
+void matrix::mnoz_pliki(const std::string& plik_a, const std::string& plik_b, const std::string& plik_c, std::size_t limit_bajtow) {
+    MATRIX_POMIAR(wejscie_wyjscie, 0);
+    poza_pamiecia::mnoz(plik_a, plik_b, plik_c, limit_bajtow);
+}
+
 // ==================== Operatory arytmetyczne ze skalarami ====================
 
 /**
@@ -148,9 +526,9 @@ std::ostream& operator<<(std::ostream& o, const matrix& m) {
  * @return Referencja do bieżącej macierzy
  */
 matrix& matrix::operator+=(int a) {
-    for (int i = 0; i < n * n; ++i) {
-        macierz_ptr[i] += a;
-    }
+    MATRIX_POMIAR(skalar, static_cast<std::size_t>(n) * n);
+    zmieniona();
+    simd::dodaj_skalar(macierz_ptr.get(), macierz_ptr.get(), static_cast<std::size_t>(n) * n, a);
     return *this;
 }
 
@@ -160,9 +538,9 @@ matrix& matrix::operator+=(int a) {
  * @return Referencja do bieżącej macierzy
  */
 matrix& matrix::operator-=(int a) {
-    for (int i = 0; i < n * n; ++i) {
-        macierz_ptr[i] -= a;
-    }
+    MATRIX_POMIAR(skalar, static_cast<std::size_t>(n) * n);
+    zmieniona();
+    simd::odejmij_skalar(macierz_ptr.get(), macierz_ptr.get(), static_cast<std::size_t>(n) * n, a);
     return *this;
 }
 
@@ -172,9 +550,9 @@ matrix& matrix::operator-=(int a) {
  * @return Referencja do bieżącej macierzy
  */
 matrix& matrix::operator*=(int a) {
-    for (int i = 0; i < n * n; ++i) {
-        macierz_ptr[i] *= a;
-    }
+    MATRIX_POMIAR(skalar, static_cast<std::size_t>(n) * n);
+    zmieniona();
+    simd::mnoz_skalar(macierz_ptr.get(), macierz_ptr.get(), static_cast<std::size_t>(n) * n, a);
     return *this;
 }
 
@@ -183,38 +561,49 @@ matrix& matrix::operator*=(int a) {
  * @return Kopia macierzy sprzed inkrementacji
  */
 matrix matrix::operator++(int) {
-    matrix temp(n);
-    for (int i = 0; i < n * n; ++i) {
-        temp.macierz_ptr[i] = macierz_ptr[i];
-        macierz_ptr[i]++;
-    }
+    MATRIX_POMIAR(inkrementacja, static_cast<std::size_t>(n) * n);
+    zmieniona();
+    matrix temp(n, bez_zerowania_t{});
+    simd::kopiuj_i_dodaj(macierz_ptr.get(), temp.macierz_ptr.get(), static_cast<std::size_t>(n) * n, 1);
     return temp;
 }
 
 /**
  * @brief Transponuje macierz (zamienia wiersze z kolumnami)
- * @details Odbija macierz względem głównej przekątnej
+ * @details Odbija macierz względem głównej przekątnej. Macierz dzielona jest
+ * rekurencyjnie na kafle 8×8; pary kafli symetrycznych względem przekątnej
+ * zamieniane są z transpozycją w rejestrach wektorowych.
  * @return Referencja do bieżącej macierzy
  */
 matrix& matrix::odwroc(void) {
-    for (int i = 0; i < n; ++i) {
-        for (int j = i + 1; j < n; ++j) {
-            int temp = at(i, j);
-            at(i, j) = at(j, i);
-            at(j, i) = temp;
-        }
-    }
+    MATRIX_POMIAR(transpozycja, static_cast<std::size_t>(n) * n);
+    zmieniona();
+    transpozycja::w_miejscu(macierz_ptr.get(), n);
     return *this;
 }
 
+/**
+ * @brief Zwraca transpozycję macierzy, nie modyfikując bieżącej
+ * @details Wynik zapisywany jest od razu do nowego bufora, bez kopiowania
+ * macierzy przed transpozycją.
+ * @return Nowa macierz A^T
+ */
+matrix matrix::odwrocona(void) const {
+    MATRIX_POMIAR(transpozycja, static_cast<std::size_t>(n) * n);
+    matrix wynik(n, bez_zerowania_t{});
+    transpozycja::poza_miejscem(macierz_ptr.get(), wynik.macierz_ptr.get(), n);
+    return wynik;
+}
+
 /**
  * @brief Ustawia wartości na głównej przekątnej macierzy
  * @param t Tablica z wartościami (wymaga n elementów)
  * @return Referencja do bieżącej macierzy
  */
 matrix& matrix::diagonalna(int* t) {
+    MATRIX_POMIAR(wypelnianie, n);
     for (int i = 0; i < n; ++i) {
-        at(i, i) = t[i];
+        wiersz_do_zapisu(i)[i] = t[i];
     }
     return *this;
 }
@@ -227,12 +616,15 @@ matrix& matrix::diagonalna(int* t) {
  */
 matrix& matrix::diagonalna_k(int k, int* t) {
     if (k == 0) return diagonalna(t);
+    MATRIX_POMIAR(wypelnianie, n);
     int offset = abs(k);
     int limit = (k > 0) ? (n - k) : (n + k);
+    if (limit <= 0) return *this;
+    // Element (i, i + k) leży o n + 1 pozycji za (i - 1, i - 1 + k)
+    zmieniona();
+    int* p = macierz_ptr.get() + ((k > 0) ? offset : static_cast<std::size_t>(offset) * n);
     for (int i = 0; i < limit; ++i) {
-        int row = (k > 0) ? i : (i + offset);
-        int col = (k > 0) ? (i + offset) : i;
-        at(row, col) = t[i];
+        p[static_cast<std::size_t>(i) * (n + 1)] = t[i];
     }
     return *this;
 }
@@ -245,9 +637,10 @@ matrix& matrix::diagonalna_k(int k, int* t) {
  * @throw std::logic_error Jeśli indeks jest poza zakresem
  */
 matrix& matrix::kolumna(int x, int* t) {
-    if (x >= n) throw std::logic_error("Zly indeks kolumny");
+    MATRIX_POMIAR(wypelnianie, n);
+    if (x >= n || x < 0) throw std::logic_error("Zly indeks kolumny");
     for (int i = 0; i < n; ++i) {
-        at(i, x) = t[i];
+        wiersz_do_zapisu(i)[x] = t[i];
     }
     return *this;
 }
@@ -260,10 +653,9 @@ matrix& matrix::kolumna(int x, int* t) {
  * @throw std::logic_error Jeśli indeks jest poza zakresem
  */
 matrix& matrix::wiersz(int y, int* t) {
-    if (y >= n) throw std::logic_error("Zly indeks wiersza");
-    for (int i = 0; i < n; ++i) {
-        at(y, i) = t[i];
-    }
+    MATRIX_POMIAR(wypelnianie, n);
+    if (y >= n || y < 0) throw std::logic_error("Zly indeks wiersza");
+    std::copy(t, t + n, wiersz_do_zapisu(y).begin());
     return *this;
 }
 
@@ -272,10 +664,11 @@ matrix& matrix::wiersz(int y, int* t) {
  * @return Referencja do bieżącej macierzy
  */
 matrix& matrix::przekatna(void) {
+    MATRIX_POMIAR(wypelnianie, static_cast<std::size_t>(n) * n);
+    zmieniona();
+    std::fill(macierz_ptr.get(), macierz_ptr.get() + static_cast<std::size_t>(n) * n, 0);
     for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            at(i, j) = (i == j) ? 1 : 0;
-        }
+        wiersz_do_zapisu(i)[i] = 1;
     }
     return *this;
 }
@@ -285,10 +678,11 @@ matrix& matrix::przekatna(void) {
  * @return Referencja do bieżącej macierzy
  */
 matrix& matrix::pod_przekatna(void) {
+    MATRIX_POMIAR(wypelnianie, static_cast<std::size_t>(n) * n);
     for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            at(i, j) = (i > j) ? 1 : 0;
-        }
+        std::span<int> r = wiersz_do_zapisu(i);
+        std::fill(r.begin(), r.begin() + i, 1);
+        std::fill(r.begin() + i, r.end(), 0);
     }
     return *this;
 }
@@ -298,10 +692,11 @@ matrix& matrix::pod_przekatna(void) {
  * @return Referencja do bieżącej macierzy
  */
 matrix& matrix::nad_przekatna(void) {
+    MATRIX_POMIAR(wypelnianie, static_cast<std::size_t>(n) * n);
     for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            at(i, j) = (i < j) ? 1 : 0;
-        }
+        std::span<int> r = wiersz_do_zapisu(i);
+        std::fill(r.begin(), r.begin() + i + 1, 0);
+        std::fill(r.begin() + i + 1, r.end(), 1);
     }
     return *this;
 }
@@ -318,13 +713,16 @@ matrix& matrix::nad_przekatna(void) {
  * @throw std::logic_error Gdy rozmiar <= 0
  */
 matrix& matrix::alokuj(int rozmiar) {
+    MATRIX_POMIAR(alokuj, static_cast<std::size_t>(rozmiar > 0 ? rozmiar : 0) * rozmiar);
+    zmieniona();
     if (rozmiar <= 0)
         throw std::logic_error("Rozmiar musi byc dodatni");
 
     // Brak pamięci lub za mało pamięci
     if (allocated_n == 0 || allocated_n < rozmiar) {
-        macierz_ptr = std::make_unique<int[]>(rozmiar * rozmiar);
+        macierz_ptr = pamiec::przydziel(static_cast<std::size_t>(rozmiar) * rozmiar);
         allocated_n = rozmiar;
+        udostepniona = false;
 
         for (int i = 0; i < rozmiar * rozmiar; ++i)
             macierz_ptr[i] = 0;
@@ -340,11 +738,10 @@ matrix& matrix::alokuj(int rozmiar) {
  * @return Kopia macierzy sprzed dekrementacji
  */
 matrix matrix::operator--(int) {
-    matrix temp(n);
-    for (int i = 0; i < n * n; ++i) {
-        temp.macierz_ptr[i] = macierz_ptr[i];
-        macierz_ptr[i]--;
-    }
+    MATRIX_POMIAR(inkrementacja, static_cast<std::size_t>(n) * n);
+    zmieniona();
+    matrix temp(n, bez_zerowania_t{});
+    simd::kopiuj_i_dodaj(macierz_ptr.get(), temp.macierz_ptr.get(), static_cast<std::size_t>(n) * n, -1);
     return temp;
 }
 
@@ -354,10 +751,10 @@ matrix matrix::operator--(int) {
  * @return Referencja do bieżącej macierzy
  */
 matrix& matrix::operator()(double d) {
+    MATRIX_POMIAR(skalar, static_cast<std::size_t>(n) * n);
+    zmieniona();
     int wartosc = static_cast<int>(d);
-    for (int i = 0; i < n * n; ++i) {
-        macierz_ptr[i] += wartosc;
-    }
+    simd::dodaj_skalar(macierz_ptr.get(), macierz_ptr.get(), static_cast<std::size_t>(n) * n, wartosc);
     return *this;
 }
 
@@ -367,11 +764,12 @@ matrix& matrix::operator()(double d) {
  * @return true jeśli macierze mają ten sam rozmiar i wszystkie elementy są równe
  */
 bool matrix::operator==(const matrix& m) const {
+    MATRIX_POMIAR(porownanie, static_cast<std::size_t>(n) * n);
     if (n != m.n) return false;
-    for (int i = 0; i < n * n; ++i) {
-        if (macierz_ptr[i] != m.macierz_ptr[i]) return false;
-    }
-    return true;
+    std::uint64_t s1 = zapamietany_skrot.load(std::memory_order_relaxed);
+    std::uint64_t s2 = m.zapamietany_skrot.load(std::memory_order_relaxed);
+    if (s1 != 0 && s2 != 0 && s1 != s2) return false;
+    return simd::rowne(macierz_ptr.get(), m.macierz_ptr.get(), static_cast<std::size_t>(n) * n);
 }
 
 /**
@@ -380,11 +778,9 @@ bool matrix::operator==(const matrix& m) const {
  * @return true jeśli każdy element tej macierzy > odpowiadający element m
  */
 bool matrix::operator>(const matrix& m) const {
+    MATRIX_POMIAR(porownanie, static_cast<std::size_t>(n) * n);
     if (n != m.n) return false;
-    for (int i = 0; i < n * n; ++i) {
-        if (macierz_ptr[i] <= m.macierz_ptr[i]) return false;
-    }
-    return true;
+    return simd::mniejsze(m.macierz_ptr.get(), macierz_ptr.get(), static_cast<std::size_t>(n) * n);
 }
 
 /**
@@ -393,11 +789,26 @@ bool matrix::operator>(const matrix& m) const {
  * @return true jeśli każdy element tej macierzy < odpowiadający element m
  */
 bool matrix::operator<(const matrix& m) const {
+    MATRIX_POMIAR(porownanie, static_cast<std::size_t>(n) * n);
     if (n != m.n) return false;
-    for (int i = 0; i < n * n; ++i) {
-        if (macierz_ptr[i] >= m.macierz_ptr[i]) return false;
-    }
-    return true;
+    return simd::mniejsze(macierz_ptr.get(), m.macierz_ptr.get(), static_cast<std::size_t>(n) * n);
+}
+
+/**
+ * @brief Zwraca skrót zawartości, licząc go przy pierwszym wywołaniu po zmianie
+ * @details Wynik 0 oznacza brak zapamiętanego skrótu, więc jest zamieniany na 1.
+ * Równoległe wywołania mogą policzyć skrót kilka razy, ale zapiszą tę samą wartość.
+ * Dla macierzy z wydanym wskaźnikiem do zapisu skrót nie jest zapamiętywany.
+ * @return Skrót zawartości (różny od 0)
+ */
+std::uint64_t matrix::skrot() const {
+    std::uint64_t s = zapamietany_skrot.load(std::memory_order_relaxed);
+    if (s != 0) return s;
+    MATRIX_POMIAR(porownanie, static_cast<std::size_t>(n) * n);
+    s = simd::skrot(macierz_ptr.get(), static_cast<std::size_t>(n) * n);
+    if (s == 0) s = 1;
+    if (!udostepniona) zapamietany_skrot.store(s, std::memory_order_relaxed);
+    return s;
 }
 
 /**
@@ -408,13 +819,12 @@ bool matrix::operator<(const matrix& m) const {
  * @throw std::logic_error Jeśli macierze mają różne rozmiary
  */
 matrix operator+(const matrix& m1, const matrix& m2) {
+    MATRIX_POMIAR(dodawanie, static_cast<std::size_t>(m1.n) * m1.n);
     if (m1.n != m2.n) {
         throw std::logic_error("Macierze muszą mieć ten sam rozmiar do dodawania");
     }
-    matrix wynik(m1.n);
-    for (int i = 0; i < m1.n * m1.n; ++i) {
-        wynik.macierz_ptr[i] = m1.macierz_ptr[i] + m2.macierz_ptr[i];
-    }
+    matrix wynik(m1.n, matrix::bez_zerowania_t{});
+    simd::dodaj(m1.macierz_ptr.get(), m2.macierz_ptr.get(), wynik.macierz_ptr.get(), static_cast<std::size_t>(m1.n) * m1.n);
     return wynik;
 }
 
@@ -423,25 +833,229 @@ matrix operator+(const matrix& m1, const matrix& m2) {
  * @param m1 Pierwsza macierz
  * @param m2 Druga macierz
  * @return Nowa macierz będąca iloczynem macierzowym
- * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary lub (w trybie
+ * sprawdzanym) element wyniku nie mieści się w int
  */
 matrix operator*(const matrix& m1, const matrix& m2) {
+    ustawienia_akumulacji u = domyslna_akumulacja.load(std::memory_order_relaxed);
+    auto licz = [&] {
+        if (u.tryb == tryb_akumulacji::zawijanie) return matrix::mnoz(m1, m2, matrix::algorytm());
+        return matrix::mnoz(m1, m2, u.tryb, u.modul);
+    };
+    if (!pamiec_iloczynow::wlaczona() || m1.n != m2.n) return licz();
+    return z_pamieci(pamiec_iloczynow::dzialanie::iloczyn, u.tryb, u.modul, m1, &m2, m2.skrot(), licz);
+}
+
+/**
+ * @brief Wykonuje mnożenie macierzowe wybranym algorytmem
+ * @param m1 Pierwsza macierz
+ * @param m2 Druga macierz
+ * @param alg Algorytm mnożenia
+ * @return Nowa macierz będąca iloczynem macierzowym
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+matrix matrix::mnoz(const matrix& m1, const matrix& m2, algorytm_mnozenia alg) {
+    MATRIX_POMIAR(mnozenie, static_cast<std::size_t>(m1.n) * m1.n * m1.n);
+    if (m1.n != m2.n) {
+        throw std::logic_error("Macierze muszą mieć ten sam rozmiar do mnożenia");
+    }
+    matrix wynik(m1.n, bez_zerowania_t{});
+    mnoz_bufory(m1.macierz_ptr.get(), m2.macierz_ptr.get(), wynik.macierz_ptr.get(), m1.n, alg);
+    return wynik;
+}
+
+/**
+ * @brief Wykonuje mnożenie macierzowe w wybranym trybie akumulacji
+ * @param m1 Pierwsza macierz
+ * @param m2 Druga macierz
+ * @param tryb Tryb akumulacji
+ * @param modul Moduł dla trybu modulo
+ * @return Nowa macierz będąca iloczynem macierzowym
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary, modul <= 0
+ * w trybie modulo lub (w trybie sprawdzanym) element wyniku nie mieści się w int
+ */
+matrix matrix::mnoz(const matrix& m1, const matrix& m2, tryb_akumulacji tryb, int modul) {
+    MATRIX_POMIAR(mnozenie, static_cast<std::size_t>(m1.n) * m1.n * m1.n);
     if (m1.n != m2.n) {
         throw std::logic_error("Macierze muszą mieć ten sam rozmiar do mnożenia");
     }
-    matrix wynik(m1.n);
-    for (int i = 0; i < m1.n; ++i) {
-        for (int j = 0; j < m1.n; ++j) {
-            int suma = 0;
-            for (int k = 0; k < m1.n; ++k) {
-                suma += m1.at(i, k) * m2.at(k, j);
+    if (tryb == tryb_akumulacji::modulo && modul <= 0)
+        throw std::logic_error("Modul musi byc dodatni");
+    matrix wynik(m1.n, bez_zerowania_t{});
+    if (tryb == tryb_akumulacji::modulo && !(w_zakresie(m1, modul) && w_zakresie(m2, modul))) {
+        matrix a(m1), b(m2);
+        redukuj(a, modul);
+        redukuj(b, modul);
+        mnozenie::modulo(a.macierz_ptr.get(), b.macierz_ptr.get(), wynik.macierz_ptr.get(), m1.n, modul);
+        return wynik;
+    }
+    mnoz_w_trybie(m1.macierz_ptr.get(), m2.macierz_ptr.get(), wynik.macierz_ptr.get(), m1.n, tryb, modul);
+    return wynik;
+}
+
+/**
+ * @brief Podnosi macierz do potęgi k w trybie akumulacji operator*
+ * @param k Wykładnik (A^0 to macierz jednostkowa)
+ * @return Nowa macierz A^k
+ * @throw std::logic_error Jeśli k < 0 lub (w trybie sprawdzanym) element
+ * wyniku pośredniego nie mieści się w int
+ */
+matrix matrix::potega(int k) const {
+    ustawienia_akumulacji u = domyslna_akumulacja.load(std::memory_order_relaxed);
+    if (u.tryb == tryb_akumulacji::modulo) return potega(k, u.modul);
+    auto licz = [&] {
+        return potega(*this, k, [u](const int* a, const int* b, int* c, int n) { mnoz_w_trybie(a, b, c, n, u.tryb, u.modul); });
+    };
+    if (!pamiec_iloczynow::wlaczona() || k < 0) return licz();
+    return z_pamieci(pamiec_iloczynow::dzialanie::potega, u.tryb, 0, *this, nullptr, static_cast<std::uint64_t>(k), licz);
+}
+
+/**
+ * @brief Podnosi macierz do potęgi k modulo modul
+ * @param k Wykładnik (A^0 to macierz jednostkowa)
+ * @param modul Moduł (> 0)
+ * @return Nowa macierz A^k mod modul
+ * @throw std::logic_error Jeśli k < 0 lub modul <= 0
+ */
+matrix matrix::potega(int k, int modul) const {
+    if (modul <= 0)
+        throw std::logic_error("Modul musi byc dodatni");
+    auto licz = [&] {
+        matrix podstawa(*this);
+        redukuj(podstawa, modul);
+        matrix wynik = potega(std::move(podstawa), k,
+            [modul](const int* a, const int* b, int* c, int n) { mnozenie::modulo(a, b, c, n, modul); });
+        if (k == 0 && modul == 1) std::fill(wynik.macierz_ptr.get(), wynik.macierz_ptr.get() + static_cast<std::size_t>(n) * n, 0);
+        return wynik;
+    };
+    if (!pamiec_iloczynow::wlaczona() || k < 0) return licz();
+    return z_pamieci(pamiec_iloczynow::dzialanie::potega, tryb_akumulacji::modulo, modul, *this, nullptr, static_cast<std::uint64_t>(k), licz);
+}
+
+/**
+ * @brief Potęgowanie przez podnoszenie do kwadratu z podanym jądrem mnożenia
+ * @details Bufory wyniku, podstawy i iloczynu są zamieniane wskaźnikami,
+ * więc poza nimi trzema nic nie jest alokowane.
+ * @param podstawa Potęgowana macierz (jej bufor jest używany jako roboczy)
+ * @param k Wykładnik
+ * @param iloczyn Jądro C = A * B na buforach n×n
+ * @return Nowa macierz A^k
+ * @throw std::logic_error Jeśli k < 0
+ */
+matrix matrix::potega(matrix podstawa, int k, const std::function<void(const int*, const int*, int*, int)>& iloczyn) {
+    if (k < 0)
+        throw std::logic_error("Wykladnik musi byc nieujemny");
+    unsigned int w = static_cast<unsigned int>(k);
+    int n = podstawa.n;
+    // Liczba mnożeń: jedno na każdy bit poza najwyższym i jedno na każdą jedynkę poza pierwszą
+    MATRIX_POMIAR(mnozenie, static_cast<std::size_t>(n) * n * n * (w == 0 ? 0 : std::bit_width(w) + std::popcount(w) - 2));
+    if (w == 0) {
+        matrix jednostkowa(n);
+        return jednostkowa.przekatna();
+    }
+
+    matrix wynik(n, bez_zerowania_t{});
+    matrix tymczasowa(n, bez_zerowania_t{});
+    bool wynik_pusty = true; // wynik to jeszcze macierz jednostkowa
+    while (true) {
+        if (w & 1) {
+            if (wynik_pusty) {
+                std::copy(podstawa.macierz_ptr.get(), podstawa.macierz_ptr.get() + static_cast<std::size_t>(n) * n, wynik.macierz_ptr.get());
+                wynik_pusty = false;
+            }
+            else {
+                iloczyn(wynik.macierz_ptr.get(), podstawa.macierz_ptr.get(), tymczasowa.macierz_ptr.get(), n);
+                wynik.macierz_ptr.swap(tymczasowa.macierz_ptr);
             }
-            wynik.at(i, j) = suma;
         }
+        w >>= 1;
+        if (w == 0) break;
+        iloczyn(podstawa.macierz_ptr.get(), podstawa.macierz_ptr.get(), tymczasowa.macierz_ptr.get(), n);
+        podstawa.macierz_ptr.swap(tymczasowa.macierz_ptr);
     }
     return wynik;
 }
 
+/**
+ * @brief Ustawia algorytm używany przez operator*
+ * @param alg Nowy domyślny algorytm
+ */
+void matrix::ustaw_algorytm(algorytm_mnozenia alg) {
+    domyslny_algorytm.store(alg, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Zwraca algorytm używany przez operator*
+ * @return Aktualny domyślny algorytm mnożenia
+ */
+algorytm_mnozenia matrix::algorytm() {
+    return domyslny_algorytm.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Ustawia tryb akumulacji używany przez operator* i potega(k)
+ * @param tryb Nowy tryb
+ * @param modul Moduł dla trybu modulo
+ * @throw std::logic_error Jeśli tryb to modulo, a modul <= 0
+ */
+void matrix::ustaw_akumulacje(tryb_akumulacji tryb, int modul) {
+    if (tryb == tryb_akumulacji::modulo && modul <= 0)
+        throw std::logic_error("Modul musi byc dodatni");
+    if (tryb != tryb_akumulacji::modulo) modul = 0;
+    domyslna_akumulacja.store({ tryb, modul }, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Zwraca tryb akumulacji używany przez operator*
+ * @return Aktualny tryb akumulacji
+ */
+tryb_akumulacji matrix::akumulacja() {
+    return domyslna_akumulacja.load(std::memory_order_relaxed).tryb;
+}
+
+/**
+ * @brief Zwraca moduł trybu akumulacji modulo
+ * @return Moduł (0 w innych trybach)
+ */
+int matrix::modul_akumulacji() {
+    return domyslna_akumulacja.load(std::memory_order_relaxed).modul;
+}
+
+/**
+ * @brief Ustawia próg przejścia algorytmu Strassena na mnożenie blokowe
+ * @param prog Rozmiar bloku, od którego rekurencja przestaje się dzielić
+ * @throw std::logic_error Jeśli prog <= 0
+ */
+void matrix::ustaw_prog_strassena(int prog) {
+    if (prog <= 0)
+        throw std::logic_error("Prog musi byc dodatni");
+    prog_strassena_.store(prog, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Zwraca próg przejścia algorytmu Strassena na mnożenie blokowe
+ * @return Aktualny próg
+ */
+int matrix::prog_strassena() {
+    return prog_strassena_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Ustawia liczbę wątków używanych przez operacje równoległe
+ * @param liczba Liczba wątków; 0 przywraca wartość domyślną
+ */
+void matrix::ustaw_liczbe_watkow(int liczba) {
+    watki::ustaw_liczbe_watkow(liczba);
+}
+
+/**
+ * @brief Zwraca liczbę wątków używanych przez operacje równoległe
+ * @return Liczba wątków
+ */
+int matrix::liczba_watkow() {
+    return watki::liczba_watkow();
+}
+
 /**
  * @brief Dodaje skalar do macierzy (macierz + liczba)
  * @param m Macierz
@@ -449,10 +1063,9 @@ matrix operator*(const matrix& m1, const matrix& m2) {
  * @return Nowa macierz z dodaną wartością do każdego elementu
  */
 matrix operator+(const matrix& m, int a) {
-    matrix wynik(m.n);
-    for (int i = 0; i < m.n * m.n; ++i) {
-        wynik.macierz_ptr[i] = m.macierz_ptr[i] + a;
-    }
+    MATRIX_POMIAR(skalar, static_cast<std::size_t>(m.n) * m.n);
+    matrix wynik(m.n, matrix::bez_zerowania_t{});
+    simd::dodaj_skalar(m.macierz_ptr.get(), wynik.macierz_ptr.get(), static_cast<std::size_t>(m.n) * m.n, a);
     return wynik;
 }
 
@@ -463,10 +1076,9 @@ matrix operator+(const matrix& m, int a) {
  * @return Nowa macierz z dodaną wartością do każdego elementu
  */
 matrix operator+(int a, const matrix& m) {
-    matrix wynik(m.n);
-    for (int i = 0; i < m.n * m.n; ++i) {
-        wynik.macierz_ptr[i] = a + m.macierz_ptr[i];
-    }
+    MATRIX_POMIAR(skalar, static_cast<std::size_t>(m.n) * m.n);
+    matrix wynik(m.n, matrix::bez_zerowania_t{});
+    simd::dodaj_skalar(m.macierz_ptr.get(), wynik.macierz_ptr.get(), static_cast<std::size_t>(m.n) * m.n, a);
     return wynik;
 }
 
@@ -477,10 +1089,9 @@ matrix operator+(int a, const matrix& m) {
  * @return Nowa macierz z pomnożonymi elementami
  */
 matrix operator*(const matrix& m, int a) {
-    matrix wynik(m.n);
-    for (int i = 0; i < m.n * m.n; ++i) {
-        wynik.macierz_ptr[i] = m.macierz_ptr[i] * a;
-    }
+    MATRIX_POMIAR(skalar, static_cast<std::size_t>(m.n) * m.n);
+    matrix wynik(m.n, matrix::bez_zerowania_t{});
+    simd::mnoz_skalar(m.macierz_ptr.get(), wynik.macierz_ptr.get(), static_cast<std::size_t>(m.n) * m.n, a);
     return wynik;
 }
 
@@ -501,10 +1112,9 @@ matrix operator*(int a, const matrix& m) {
  * @return Nowa macierz z odjętą wartością
  */
 matrix operator-(const matrix& m, int a) {
-    matrix wynik(m.n);
-    for (int i = 0; i < m.n * m.n; ++i) {
-        wynik.macierz_ptr[i] = m.macierz_ptr[i] - a;
-    }
+    MATRIX_POMIAR(skalar, static_cast<std::size_t>(m.n) * m.n);
+    matrix wynik(m.n, matrix::bez_zerowania_t{});
+    simd::odejmij_skalar(m.macierz_ptr.get(), wynik.macierz_ptr.get(), static_cast<std::size_t>(m.n) * m.n, a);
     return wynik;
 }
 
@@ -515,9 +1125,127 @@ matrix operator-(const matrix& m, int a) {
  * @return Nowa macierz gdzie każdy element = a - element_macierzy
  */
 matrix operator-(int a, const matrix& m) {
-    matrix wynik(m.n);
-    for (int i = 0; i < m.n * m.n; ++i) {
-        wynik.macierz_ptr[i] = a - m.macierz_ptr[i];
-    }
+    MATRIX_POMIAR(skalar, static_cast<std::size_t>(m.n) * m.n);
+    matrix wynik(m.n, matrix::bez_zerowania_t{});
+    simd::odejmij_od_skalara(m.macierz_ptr.get(), wynik.macierz_ptr.get(), static_cast<std::size_t>(m.n) * m.n, a);
     return wynik;
-}
\ No newline at end of file
+}
+
+// ==================== Friend operatory dla obiektów tymczasowych ====================
+
+/**
+ * @brief Dodaje dwie macierze, używając pamięci tymczasowej pierwszej z nich
+ * @param m1 Pierwsza macierz (tymczasowa)
+ * @param m2 Druga macierz
+ * @return Macierz m1 powiększona o m2
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+matrix operator+(matrix&& m1, const matrix& m2) {
+    MATRIX_POMIAR(tymczasowa, static_cast<std::size_t>(m1.n) * m1.n);
+    if (m1.n != m2.n) {
+        throw std::logic_error("Macierze muszą mieć ten sam rozmiar do dodawania");
+    }
+    m1.zmieniona();
+    simd::dodaj(m1.macierz_ptr.get(), m2.macierz_ptr.get(), m1.macierz_ptr.get(), static_cast<std::size_t>(m1.n) * m1.n);
+    return std::move(m1);
+}
+
+/**
+ * @brief Dodaje dwie macierze, używając pamięci tymczasowej drugiej z nich
+ * @param m1 Pierwsza macierz
+ * @param m2 Druga macierz (tymczasowa)
+ * @return Macierz m2 powiększona o m1
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+matrix operator+(const matrix& m1, matrix&& m2) {
+    return std::move(m2) + m1;
+}
+
+/**
+ * @brief Dodaje dwie tymczasowe macierze, używając pamięci pierwszej z nich
+ * @param m1 Pierwsza macierz (tymczasowa)
+ * @param m2 Druga macierz (tymczasowa)
+ * @return Macierz m1 powiększona o m2
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+matrix operator+(matrix&& m1, matrix&& m2) {
+    return std::move(m1) + static_cast<const matrix&>(m2);
+}
+
+/**
+ * @brief Dodaje skalar do tymczasowej macierzy w miejscu (macierz + liczba)
+ * @param m Macierz (tymczasowa)
+ * @param a Wartość do dodania
+ * @return Macierz m z dodaną wartością
+ */
+matrix operator+(matrix&& m, int a) {
+    MATRIX_POMIAR(tymczasowa, static_cast<std::size_t>(m.n) * m.n);
+    m.zmieniona();
+    simd::dodaj_skalar(m.macierz_ptr.get(), m.macierz_ptr.get(), static_cast<std::size_t>(m.n) * m.n, a);
+    return std::move(m);
+}
+
+/**
+ * @brief Dodaje skalar do tymczasowej macierzy w miejscu (liczba + macierz)
+ * @param a Wartość do dodania
+ * @param m Macierz (tymczasowa)
+ * @return Macierz m z dodaną wartością
+ */
+matrix operator+(int a, matrix&& m) {
+    MATRIX_POMIAR(tymczasowa, static_cast<std::size_t>(m.n) * m.n);
+    m.zmieniona();
+    simd::dodaj_skalar(m.macierz_ptr.get(), m.macierz_ptr.get(), static_cast<std::size_t>(m.n) * m.n, a);
+    return std::move(m);
+}
+
+/**
+ * @brief Mnoży tymczasową macierz przez skalar w miejscu (macierz * liczba)
+ * @param m Macierz (tymczasowa)
+ * @param a Mnożnik
+ * @return Macierz m z pomnożonymi elementami
+ */
+matrix operator*(matrix&& m, int a) {
+    MATRIX_POMIAR(tymczasowa, static_cast<std::size_t>(m.n) * m.n);
+    m.zmieniona();
+    simd::mnoz_skalar(m.macierz_ptr.get(), m.macierz_ptr.get(), static_cast<std::size_t>(m.n) * m.n, a);
+    return std::move(m);
+}
+
+/**
+ * @brief Mnoży tymczasową macierz przez skalar w miejscu (liczba * macierz)
+ * @param a Mnożnik
+ * @param m Macierz (tymczasowa)
+ * @return Macierz m z pomnożonymi elementami
+ */
+matrix operator*(int a, matrix&& m) {
+    MATRIX_POMIAR(tymczasowa, static_cast<std::size_t>(m.n) * m.n);
+    m.zmieniona();
+    simd::mnoz_skalar(m.macierz_ptr.get(), m.macierz_ptr.get(), static_cast<std::size_t>(m.n) * m.n, a);
+    return std::move(m);
+}
+
+/**
+ * @brief Odejmuje skalar od tymczasowej macierzy w miejscu (macierz - liczba)
+ * @param m Macierz (tymczasowa)
+ * @param a Wartość do odjęcia
+ * @return Macierz m z odjętą wartością
+ */
+matrix operator-(matrix&& m, int a) {
+    MATRIX_POMIAR(tymczasowa, static_cast<std::size_t>(m.n) * m.n);
+    m.zmieniona();
+    simd::odejmij_skalar(m.macierz_ptr.get(), m.macierz_ptr.get(), static_cast<std::size_t>(m.n) * m.n, a);
+    return std::move(m);
+}
+
+/**
+ * @brief Odejmuje tymczasową macierz od skalara w miejscu (liczba - macierz)
+ * @param a Wartość bazowa
+ * @param m Macierz (tymczasowa)
+ * @return Macierz m, gdzie każdy element = a - element
+ */
+matrix operator-(int a, matrix&& m) {
+    MATRIX_POMIAR(tymczasowa, static_cast<std::size_t>(m.n) * m.n);
+    m.zmieniona();
+    simd::odejmij_od_skalara(m.macierz_ptr.get(), m.macierz_ptr.get(), static_cast<std::size_t>(m.n) * m.n, a);
+    return std::move(m);
+}
@@ -1,30 +1,153 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 
+#include <atomic>
+#include <cassert>
 #include <iostream>
 #include <memory>
 #include <vector>
 #include <random>
+#include <span>
 #include <iomanip>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "pamiec.h"
+
+namespace wyrazenia {
+    template <class E> class wyrazenie;
+    class lisc;
+}
+
+template <int N> class macierz_stala;
+class macierz_rzadka;
+class macierz_bitowa;
+class pakiet_macierzy;
 
 /**
  * @file matrix.h
  * @brief Deklaracja klasy matrix reprezentującej macierz kwadratową liczb całkowitych
  */
 
+/**
+ * @enum algorytm_mnozenia
+ * @brief Algorytm używany do mnożenia macierzowego
+ */
+enum class algorytm_mnozenia {
+    naiwny,  ///< Referencyjna pętla i-j-k (do weryfikacji wyników)
+    blokowy, ///< Mnożenie blokowane (L1/L2/L3) z pakowaniem i mikrojądrem rejestrowym
+    rownolegly, ///< Mnożenie blokowane dzielone na kafle liczone przez pulę wątków
+    strassen ///< Rekurencja Strassena-Winograda z przejściem na mnożenie blokowe poniżej progu
+};
+
+/**
+ * @enum tryb_akumulacji
+ * @brief Sposób sumowania iloczynów w mnożeniu macierzowym
+ */
+enum class tryb_akumulacji {
+    zawijanie,  ///< Arytmetyka modulo 2^32 jądrem algorytm() (domyślny, najszybszy)
+    sprawdzany, ///< Sumy 64-bitowe; element wyniku spoza zakresu int zgłasza wyjątek
+    nasycany,   ///< Sumy 64-bitowe; element wyniku spoza zakresu int zastępowany przez INT_MIN/INT_MAX
+    modulo      ///< Arytmetyka modulo p z redukcją Barretta; wynik w [0, p)
+};
+
  /**
   * @class matrix
   * @brief Klasa reprezentująca kwadratową macierz liczb całkowitych
   *
   * Klasa zapewnia pełną funkcjonalność operacji na macierzach kwadratowych,
   * w tym operacje arytmetyczne, porównania, transformacje i wypełnianie wzorami.
-  * Pamięć jest zarządzana automatycznie przez std::unique_ptr.
+  * Pamięć jest zarządzana automatycznie przez std::unique_ptr z deleterem
+  * zwracającym bufory do puli (zob. pamiec.h).
   */
 class matrix {
 private:
     int n;                              ///< Aktualny rozmiar macierzy (n×n)
     int allocated_n;                    ///< Rozmiar zaalokowanej pamięci
-    std::unique_ptr<int[]> macierz_ptr; ///< Wskaźnik do danych macierzy (przechowywane wierszami)
+    pamiec::bufor macierz_ptr;          ///< Wskaźnik do danych macierzy (przechowywane wierszami, wyrównane do 64 B)
+    mutable std::atomic<std::uint64_t> zapamietany_skrot{ 0 }; ///< Skrót zawartości obliczony przez skrot() (0 = nieznany)
+    bool udostepniona = false;          ///< Wydano wskaźnik do zapisu w bufor, więc skrót nie jest zapamiętywany
+
+    /**
+     * @brief Unieważnia zapamiętany skrót; wywoływana przez każdą metodę zmieniającą dane
+     */
+    void zmieniona() { zapamietany_skrot.store(0, std::memory_order_relaxed); }
+
+    /**
+     * @brief Unieważnia skrót i wyłącza jego zapamiętywanie do czasu wymiany bufora
+     * @details Wywoływana przez niestałe metody zwracające wskaźnik, widok lub
+     * referencję, przez które dane mogą się zmienić bez wiedzy obiektu.
+     */
+    void udostepnij() {
+        zmieniona();
+        udostepniona = true;
+    }
+
+    /**
+     * @brief Zwraca widok do zapisu na wiersz na potrzeby metod klasy (nie wyłącza zapamiętywania skrótu)
+     * @param i Indeks wiersza (0-based)
+     * @return Widok n elementów wiersza i
+     */
+    std::span<int> wiersz_do_zapisu(int i) {
+        assert(i >= 0 && i < n);
+        zmieniona();
+        return { macierz_ptr.get() + static_cast<std::size_t>(i) * n, static_cast<std::size_t>(n) };
+    }
+
+    /// Znacznik konstruktora, który nie zeruje danych (wynik zostanie nadpisany)
+    struct bez_zerowania_t {};
+
+    /**
+     * @brief Konstruktor tworzący macierz n×n bez inicjalizacji elementów
+     * @param n Rozmiar macierzy kwadratowej
+     */
+    matrix(int n, bez_zerowania_t);
+
+    /**
+     * @brief Zapewnia bufor na rozmiar×rozmiar elementów, bez zerowania nowej pamięci
+     * @details Przy realokacji stary bufor jest zwalniany, a zapamiętywanie
+     * skrótu znów włączone; rozmiar logiczny n nie jest zmieniany.
+     * @param rozmiar Wymagany rozmiar macierzy
+     */
+    void zarezerwuj(int rozmiar);
+
+    /**
+     * @brief Konstruktor przejmujący gotowy bufor danych (np. zmapowany plik)
+     * @param n Rozmiar macierzy kwadratowej
+     * @param dane Bufor z n*n elementami
+     */
+    matrix(int n, pamiec::bufor dane);
+
+    /**
+     * @brief Zapisuje wartości wyrażenia do danych macierzy jednym przebiegiem
+     * @param e Wyrażenie o rozmiarze równym n
+     */
+    template <class E>
+    void oblicz(const E& e) {
+        zmieniona();
+        int* dane = macierz_ptr.get();
+        std::size_t ile = static_cast<std::size_t>(n) * n;
+        for (std::size_t i = 0; i < ile; ++i) dane[i] = e[i];
+    }
+
+    /**
+     * @brief Potęgowanie przez podnoszenie do kwadratu z podanym jądrem mnożenia
+     * @param podstawa Potęgowana macierz (jej bufor jest używany jako roboczy)
+     * @param k Wykładnik
+     * @param iloczyn Jądro C = A * B na buforach n×n
+     * @return Nowa macierz podstawa^k
+     */
+    static matrix potega(matrix podstawa, int k, const std::function<void(const int*, const int*, int*, int)>& iloczyn);
+
+    friend class wyrazenia::lisc;
+    template <int N> friend class macierz_stala;
+    friend class macierz_rzadka;
+    friend class macierz_bitowa;
+    friend class pakiet_macierzy;
+    friend matrix operator*(const macierz_rzadka& a, const matrix& b);
+    friend matrix operator*(const matrix& a, const macierz_rzadka& b);
+    friend matrix iloczyn_zliczajacy(const macierz_bitowa& a, const macierz_bitowa& b);
 
 public:
     // ==================== Konstruktory i destruktor ====================
@@ -54,10 +177,55 @@ public:
     matrix(const matrix& m);
 
     /**
-     * @brief Konstruktor przenoszący (domyślny)
+     * @brief Konstruktor przenoszący - przejmuje pamięć, źródło staje się macierzą 0×0
      * @param other Macierz do przeniesienia
      */
-    matrix(matrix&& other) noexcept = default;
+    matrix(matrix&& other) noexcept;
+
+    /**
+     * @brief Przypisanie kopiujące
+     * @details Istniejąca pamięć jest używana ponownie, jeśli allocated_n
+     * wystarcza na rozmiar źródła (tak jak w alokuj)
+     * @param m Macierz źródłowa do skopiowania
+     * @return Referencja do bieżącej macierzy
+     */
+    matrix& operator=(const matrix& m);
+
+    /**
+     * @brief Przypisanie przenoszące - przejmuje pamięć źródła bez kopiowania
+     * @details Źródło staje się macierzą 0×0
+     * @param m Macierz do przeniesienia
+     * @return Referencja do bieżącej macierzy
+     */
+    matrix& operator=(matrix&& m) noexcept;
+
+    /**
+     * @brief Konstruktor obliczający leniwe wyrażenie (zob. wyrazenia.h)
+     * @details Wynik zapisywany jest jednym przebiegiem, bez macierzy tymczasowych
+     * @param w Wyrażenie element po elemencie
+     */
+    template <class E>
+    matrix(const wyrazenia::wyrazenie<E>& w) : matrix(w.self().rozmiar(), bez_zerowania_t{}) {
+        oblicz(w.self());
+    }
+
+    /**
+     * @brief Przypisuje wynik leniwego wyrażenia (zob. wyrazenia.h)
+     * @details Istniejąca pamięć jest używana ponownie, jeśli wystarcza;
+     * nowa nie jest zerowana, więc wynik zapisywany jest jednym przebiegiem.
+     * Macierz może występować w wyrażeniu po prawej stronie (ma wtedy jego
+     * rozmiar, więc bufor nie jest wymieniany).
+     * @param w Wyrażenie element po elemencie
+     * @return Referencja do bieżącej macierzy
+     */
+    template <class E>
+    matrix& operator=(const wyrazenia::wyrazenie<E>& w) {
+        const E& e = w.self();
+        zarezerwuj(e.rozmiar());
+        n = e.rozmiar();
+        oblicz(e);
+        return *this;
+    }
 
     /**
      * @brief Destruktor
@@ -91,6 +259,71 @@ public:
      */
     int pokaz(int x, int y) const { return at(x, y); }
 
+    // ==================== Dostęp bez sprawdzania ====================
+    // Indeksy sprawdzane są tylko asercjami (w budowaniu bez NDEBUG).
+    // Wersje niestałe unieważniają zapamiętany skrót i wyłączają jego
+    // zapamiętywanie (zob. skrot()).
+
+    /**
+     * @brief Zwraca widok na wiersz macierzy
+     * @param i Indeks wiersza (0-based)
+     * @return Widok n elementów wiersza i
+     */
+    std::span<int> row(int i) {
+        udostepnij();
+        return wiersz_do_zapisu(i);
+    }
+
+    /**
+     * @brief Zwraca widok tylko do odczytu na wiersz macierzy
+     * @param i Indeks wiersza (0-based)
+     * @return Widok n elementów wiersza i
+     */
+    std::span<const int> row(int i) const {
+        assert(i >= 0 && i < n);
+        return { macierz_ptr.get() + static_cast<std::size_t>(i) * n, static_cast<std::size_t>(n) };
+    }
+
+    /**
+     * @brief Dostęp do wiersza bez sprawdzania zakresu: m[i][j]
+     * @param i Indeks wiersza (0-based)
+     * @return Widok wiersza i
+     */
+    std::span<int> operator[](int i) { return row(i); }
+
+    /**
+     * @brief Dostęp do wiersza tylko do odczytu bez sprawdzania zakresu: m[i][j]
+     * @param i Indeks wiersza (0-based)
+     * @return Widok wiersza i
+     */
+    std::span<const int> operator[](int i) const { return row(i); }
+
+    /**
+     * @brief Zwraca wskaźnik na dane macierzy (n*n elementów, wierszami, wyrównane do 64 B)
+     */
+    int* data() {
+        udostepnij();
+        return macierz_ptr.get();
+    }
+
+    /**
+     * @brief Zwraca wskaźnik tylko do odczytu na dane macierzy
+     */
+    const int* data() const { return macierz_ptr.get(); }
+
+    /// Iterator na pierwszy element (przejście wierszami)
+    int* begin() { return data(); }
+    /// Iterator za ostatnim elementem
+    int* end() { return data() + static_cast<std::size_t>(n) * n; }
+    /// Iterator tylko do odczytu na pierwszy element
+    const int* begin() const { return macierz_ptr.get(); }
+    /// Iterator tylko do odczytu za ostatnim elementem
+    const int* end() const { return macierz_ptr.get() + static_cast<std::size_t>(n) * n; }
+    /// Iterator tylko do odczytu na pierwszy element
+    const int* cbegin() const { return begin(); }
+    /// Iterator tylko do odczytu za ostatnim elementem
+    const int* cend() const { return end(); }
+
     // ==================== Alokacja ====================
 
     /**
@@ -109,6 +342,12 @@ public:
      */
     matrix& odwroc(void);
 
+    /**
+     * @brief Zwraca transpozycję macierzy, nie modyfikując bieżącej
+     * @return Nowa macierz A^T
+     */
+    matrix odwrocona(void) const;
+
     /**
      * @brief Wypełnia macierz losowymi liczbami z zakresu [0, 9]
      * @return Referencja do bieżącej macierzy
@@ -122,6 +361,17 @@ public:
      */
     matrix& losuj(int x);
 
+    /**
+     * @brief Wypełnia macierz powtarzalnymi liczbami losowymi z zakresu [0, x]
+     * @details Generator licznikowy (SplitMix64) wypełnia macierz równolegle;
+     * to samo ziarno daje tę samą macierz niezależnie od liczby wątków.
+     * @param x Górna granica zakresu losowania
+     * @param ziarno Ziarno generatora
+     * @return Referencja do bieżącej macierzy
+     * @throw std::logic_error Gdy x < 0
+     */
+    matrix& losuj(int x, std::uint64_t ziarno);
+
     /**
      * @brief Ustawia wartości na głównej przekątnej macierzy
      * @param t Tablica zawierająca n wartości dla przekątnej
@@ -225,6 +475,9 @@ public:
 
     /**
      * @brief Sprawdza równość dwóch macierzy
+     * @details Jeśli obie macierze mają już zapamiętany skrót (zob. skrot())
+     * i skróty się różnią, wynik jest znany bez czytania danych. Skrót nie jest
+     * zapamiętywany dla macierzy, której bufor mógł zmienić się z zewnątrz.
      * @param m Macierz do porównania
      * @return true jeśli macierze mają ten sam rozmiar i identyczne elementy
      */
@@ -244,6 +497,19 @@ public:
      */
     bool operator<(const matrix& m) const;
 
+    /**
+     * @brief Zwraca 64-bitowy skrót zawartości macierzy (zob. simd::skrot)
+     * @details Skrót liczony jest przy pierwszym wywołaniu i zapamiętywany do
+     * najbliższej zmiany danych. Po wywołaniu niestałych at(), row(),
+     * operator[], data(), begin() lub end() dane mogą zmieniać się przez
+     * wydany wskaźnik, więc skrót jest wtedy liczony przy każdym wywołaniu,
+     * dopóki bufor nie zostanie wymieniony (np. przypisaniem). Równe macierze
+     * mają równe skróty; skrót nigdy nie jest równy 0 i zmienia się między
+     * uruchomieniami programu (zob. simd::skrot).
+     * @return Skrót zależny od rozmiaru i wszystkich elementów
+     */
+    std::uint64_t skrot() const;
+
     // ==================== Friend operatory ====================
 
     /**
@@ -257,10 +523,14 @@ public:
 
     /**
      * @brief Wykonuje mnożenie macierzowe
+     * @details Używa algorytmu algorytm() i trybu akumulacji akumulacja().
+     * Przy włączonej pamięci iloczynów (zob. pamiec_iloczynow.h) wynik dla
+     * argumentów o tej samej zawartości jest kopiowany z pamięci.
      * @param m1 Pierwsza macierz
      * @param m2 Druga macierz
      * @return Nowa macierz będąca iloczynem macierzowym
-     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary lub (w trybie
+     * sprawdzanym) element wyniku nie mieści się w int
      */
     friend matrix operator*(const matrix& m1, const matrix& m2);
 
@@ -312,6 +582,85 @@ public:
      */
     friend matrix operator-(int a, const matrix& m);
 
+    // ==================== Friend operatory dla obiektów tymczasowych ====================
+    // Wynik zapisywany jest w miejscu, w pamięci wygasającego argumentu,
+    // więc łańcuch działań alokuje pamięć tylko raz.
+
+    /**
+     * @brief Dodaje dwie macierze, używając pamięci tymczasowej pierwszej z nich
+     * @param m1 Pierwsza macierz (tymczasowa)
+     * @param m2 Druga macierz
+     * @return Macierz m1 powiększona o m2
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    friend matrix operator+(matrix&& m1, const matrix& m2);
+
+    /**
+     * @brief Dodaje dwie macierze, używając pamięci tymczasowej drugiej z nich
+     * @param m1 Pierwsza macierz
+     * @param m2 Druga macierz (tymczasowa)
+     * @return Macierz m2 powiększona o m1
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    friend matrix operator+(const matrix& m1, matrix&& m2);
+
+    /**
+     * @brief Dodaje dwie tymczasowe macierze, używając pamięci pierwszej z nich
+     * @param m1 Pierwsza macierz (tymczasowa)
+     * @param m2 Druga macierz (tymczasowa)
+     * @return Macierz m1 powiększona o m2
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    friend matrix operator+(matrix&& m1, matrix&& m2);
+
+    /**
+     * @brief Dodaje skalar do tymczasowej macierzy w miejscu (macierz + liczba)
+     * @param m Macierz (tymczasowa)
+     * @param a Wartość do dodania
+     * @return Macierz m z dodaną wartością
+     */
+    friend matrix operator+(matrix&& m, int a);
+
+    /**
+     * @brief Dodaje skalar do tymczasowej macierzy w miejscu (liczba + macierz)
+     * @param a Wartość do dodania
+     * @param m Macierz (tymczasowa)
+     * @return Macierz m z dodaną wartością
+     */
+    friend matrix operator+(int a, matrix&& m);
+
+    /**
+     * @brief Mnoży tymczasową macierz przez skalar w miejscu (macierz * liczba)
+     * @param m Macierz (tymczasowa)
+     * @param a Mnożnik
+     * @return Macierz m z pomnożonymi elementami
+     */
+    friend matrix operator*(matrix&& m, int a);
+
+    /**
+     * @brief Mnoży tymczasową macierz przez skalar w miejscu (liczba * macierz)
+     * @param a Mnożnik
+     * @param m Macierz (tymczasowa)
+     * @return Macierz m z pomnożonymi elementami
+     */
+    friend matrix operator*(int a, matrix&& m);
+
+    /**
+     * @brief Odejmuje skalar od tymczasowej macierzy w miejscu (macierz - liczba)
+     * @param m Macierz (tymczasowa)
+     * @param a Wartość do odjęcia
+     * @return Macierz m z odjętą wartością
+     */
+    friend matrix operator-(matrix&& m, int a);
+
+    /**
+     * @brief Odejmuje tymczasową macierz od skalara w miejscu (liczba - macierz)
+     * @param a Wartość bazowa
+     * @param m Macierz (tymczasowa)
+     * @return Macierz m, gdzie każdy element = a - element
+     */
+    friend matrix operator-(int a, matrix&& m);
+
     /**
      * @brief Operator wyjścia - wypisuje macierz do strumienia
      * @param o Strumień wyjściowy
@@ -320,6 +669,168 @@ public:
      */
     friend std::ostream& operator<<(std::ostream& o, const matrix& m);
 
+    /**
+     * @brief Operator wejścia - wczytuje macierz w formacie operatora wyjścia
+     * @details Puste linie przed macierzą są pomijane, więc macierze
+     * rozdzielone std::endl można wczytywać kolejno. Rozmiar n wyznacza
+     * liczba wartości w pierwszym niepustym wierszu; wczytywanych jest
+     * dokładnie n wierszy. Przy błędnych danych ustawiany
+     * jest failbit, a macierz pozostaje bez zmian.
+     * @param i Strumień wejściowy
+     * @param m Macierz docelowa
+     * @return Referencja do strumienia
+     */
+    friend std::istream& operator>>(std::istream& i, matrix& m);
+
+    // ==================== Pliki binarne ====================
+
+    /**
+     * @brief Zapisuje macierz do pliku w formacie binarnym (zob. plik.h)
+     * @details Plik jest zastępowany dopiero po zapisaniu, więc wolno zapisać
+     * macierz do pliku, z którego została wczytana.
+     * @param sciezka Ścieżka pliku (nadpisywanego)
+     * @throw std::logic_error Jeśli zapis się nie powiedzie
+     */
+    void zapisz(const std::string& sciezka) const;
+
+    /**
+     * @brief Wczytuje macierz z pliku binarnego bez kopiowania danych
+     * @details Na systemach POSIX plik jest mapowany do pamięci (MAP_PRIVATE):
+     * dane nie są kopiowane ani parsowane, a strony ładowane są przy pierwszym
+     * dostępie. Modyfikacje macierzy nie zmieniają pliku.
+     * @param sciezka Ścieżka pliku
+     * @return Wczytana macierz
+     * @throw std::logic_error Jeśli plik jest niepoprawny
+     */
+    static matrix wczytaj(const std::string& sciezka);
+
+    /**
+     * @brief Mnoży macierze zapisane w plikach binarnych, nie wczytując ich w całości
+     * @details Wynik liczony jest kafel po kaflu; kafle A i B czytane są
+     * z wyprzedzeniem przez osobny wątek, a kafle C zapisywane od razu do
+     * pliku. Zużycie pamięci nie przekracza limit_bajtow niezależnie od n.
+     * @param plik_a Ścieżka pliku macierzy A
+     * @param plik_b Ścieżka pliku macierzy B
+     * @param plik_c Ścieżka pliku wynikowego C = A * B (nadpisywanego)
+     * @param limit_bajtow Ograniczenie pamięci na bufory kafli (domyślnie 256 MiB)
+     * @throw std::logic_error Jeśli pliki są niepoprawne lub mają różne rozmiary
+     */
+    static void mnoz_pliki(const std::string& plik_a, const std::string& plik_b, const std::string& plik_c,
+                           std::size_t limit_bajtow = std::size_t(256) << 20);
+
+    // ==================== Mnożenie macierzowe ====================
+
+    /**
+     * @brief Wykonuje mnożenie macierzowe wybranym algorytmem
+     * @param m1 Pierwsza macierz
+     * @param m2 Druga macierz
+     * @param alg Algorytm mnożenia
+     * @return Nowa macierz będąca iloczynem macierzowym
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    static matrix mnoz(const matrix& m1, const matrix& m2, algorytm_mnozenia alg);
+
+    /**
+     * @brief Wykonuje mnożenie macierzowe w wybranym trybie akumulacji
+     * @details Tryby inne niż zawijanie mają własne jądro: iloczyny 32×32
+     * bity sumowane są w 64-bitowych rejestrach wektorowych, więc nie
+     * ma przepełnień pośrednich. W trybie modulo elementy spoza [0, modul)
+     * są najpierw sprowadzane do tego zakresu.
+     * @param m1 Pierwsza macierz
+     * @param m2 Druga macierz
+     * @param tryb Tryb akumulacji
+     * @param modul Moduł dla trybu modulo (> 0; w innych trybach ignorowany)
+     * @return Nowa macierz będąca iloczynem macierzowym
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary, modul <= 0
+     * w trybie modulo lub (w trybie sprawdzanym) element wyniku nie mieści się w int
+     */
+    static matrix mnoz(const matrix& m1, const matrix& m2, tryb_akumulacji tryb, int modul = 0);
+
+    /**
+     * @brief Podnosi macierz do potęgi k
+     * @details Potęgowanie przez podnoszenie do kwadratu: O(log k) mnożeń
+     * jądrem wybranym przez algorytm() i akumulacja(), na trzech buforach
+     * używanych naprzemiennie zamiast nowej macierzy na każde mnożenie.
+     * Wynik trafia do pamięci iloczynów, jeśli jest włączona.
+     * @param k Wykładnik (A^0 to macierz jednostkowa)
+     * @return Nowa macierz A^k
+     * @throw std::logic_error Jeśli k < 0
+     */
+    matrix potega(int k) const;
+
+    /**
+     * @brief Podnosi macierz do potęgi k modulo modul
+     * @details Elementy wyniku należą do [0, modul); ujemne elementy A są
+     * najpierw sprowadzane do tego zakresu. Iloczyny sumowane są
+     * w 64 bitach, więc wynik jest dokładny dla każdego modułu int.
+     * Wynik trafia do pamięci iloczynów, jeśli jest włączona.
+     * @param k Wykładnik (A^0 to macierz jednostkowa)
+     * @param modul Moduł (> 0)
+     * @return Nowa macierz A^k mod modul
+     * @throw std::logic_error Jeśli k < 0 lub modul <= 0
+     */
+    matrix potega(int k, int modul) const;
+
+    /**
+     * @brief Ustawia algorytm używany przez operator*
+     * @param alg Nowy domyślny algorytm (początkowo algorytm_mnozenia::rownolegly)
+     */
+    static void ustaw_algorytm(algorytm_mnozenia alg);
+
+    /**
+     * @brief Zwraca algorytm używany przez operator*
+     * @return Aktualny domyślny algorytm mnożenia
+     */
+    static algorytm_mnozenia algorytm();
+
+    /**
+     * @brief Ustawia tryb akumulacji używany przez operator* i potega(k)
+     * @param tryb Nowy tryb (początkowo tryb_akumulacji::zawijanie)
+     * @param modul Moduł dla trybu modulo
+     * @throw std::logic_error Jeśli tryb to modulo, a modul <= 0
+     */
+    static void ustaw_akumulacje(tryb_akumulacji tryb, int modul = 0);
+
+    /**
+     * @brief Zwraca tryb akumulacji używany przez operator*
+     * @return Aktualny tryb akumulacji
+     */
+    static tryb_akumulacji akumulacja();
+
+    /**
+     * @brief Zwraca moduł trybu akumulacji modulo
+     * @return Moduł ustawiony przez ustaw_akumulacje (0 w innych trybach)
+     */
+    static int modul_akumulacji();
+
+    /**
+     * @brief Ustawia próg przejścia algorytmu Strassena na mnożenie blokowe
+     * @param prog Rozmiar bloku, od którego rekurencja przestaje się dzielić
+     * @throw std::logic_error Jeśli prog <= 0
+     */
+    static void ustaw_prog_strassena(int prog);
+
+    /**
+     * @brief Zwraca próg przejścia algorytmu Strassena na mnożenie blokowe
+     * @return Aktualny próg
+     */
+    static int prog_strassena();
+
+    /**
+     * @brief Ustawia liczbę wątków używanych przez operacje równoległe
+     * @details Domyślna wartość pochodzi ze zmiennej środowiskowej MATRIX_WATKI,
+     * a gdy jej brak - z liczby rdzeni procesora.
+     * @param liczba Liczba wątków; 0 przywraca wartość domyślną
+     * @throw std::logic_error Jeśli wywołana z zadania puli wątków
+     */
+    static void ustaw_liczbe_watkow(int liczba);
+
+    /**
+     * @brief Zwraca liczbę wątków używanych przez operacje równoległe
+     * @return Liczba wątków
+     */
+    static int liczba_watkow();
+
     // ==================== Metody pomocnicze ====================
 
     /**
@@ -327,8 +838,9 @@ public:
      * @param x Indeks wiersza
      * @param y Indeks kolumny
      * @param val Wartość do wstawienia
+     * @throw std::logic_error Jeśli współrzędne są poza zakresem
      */
-    void wstaw(int x, int y, int val) { at(x, y) = val; }
+    void wstaw(int x, int y, int val);
 
     /**
      * @brief Zwraca rozmiar macierzy
@@ -336,4 +848,15 @@ public:
      */
     int getSize() const { return n; }
 };
+
+/**
+ * @brief Skrót macierzy dla kontenerów mieszających (np. std::unordered_set<matrix>)
+ */
+template <>
+struct std::hash<matrix> {
+    std::size_t operator()(const matrix& m) const noexcept { return static_cast<std::size_t>(m.skrot()); }
+};
+
+#include "wyrazenia.h"
+
 #endif
\ No newline at end of file
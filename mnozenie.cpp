@@ -0,0 +1,622 @@
+/**
+ * @file mnozenie.cpp
+ * @brief Implementacja jąder mnożenia macierzowego
+ */
+
+#include "mnozenie.h"
+#include "simd.h"
+#include "watki.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace {
+
+    // ==================== Parametry blokowania ====================
+
+    constexpr int MR = 4;    ///< Liczba wierszy mikrojądra
+    constexpr int NR = 16;   ///< Liczba kolumn mikrojądra
+    constexpr int KC = 256;  ///< Głębokość bloku (panel A MR×KC i panel B KC×NR mieszczą się w L1)
+    constexpr int MC = 96;   ///< Wiersze bloku A (blok MC×KC mieści się w L2)
+    constexpr int NC = 2048; ///< Kolumny bloku B (blok KC×NC mieści się w L3)
+
+    constexpr int PROG_ROWNOLEGLY = 128; ///< Minimalne n, od którego mnożenie dzielone jest na wątki
+    constexpr int MIN_KAFEL_KOLUMN = 256; ///< Najwęższy kafel kolumn przy podziale na wątki
+
+    /// Rozmiar bufora na spakowany blok A
+    constexpr int ROZMIAR_BUFORA_A = ((MC + MR - 1) / MR) * MR * KC;
+    /// Rozmiar bufora na spakowany blok B
+    constexpr int ROZMIAR_BUFORA_B = ((NC + NR - 1) / NR) * NR * KC;
+
+    /// Bufory pakowania bloków A i B
+    struct bufory_pakowania {
+        std::vector<int> a = std::vector<int>(ROZMIAR_BUFORA_A);
+        std::vector<int> b = std::vector<int>(ROZMIAR_BUFORA_B);
+    };
+
+    /**
+     * @brief Zwraca bufory pakowania bieżącego wątku
+     * @details Bufory są alokowane raz na wątek i używane ponownie przy
+     * kolejnych mnożeniach.
+     */
+    bufory_pakowania& bufory_watku() {
+        thread_local bufory_pakowania bufory;
+        return bufory;
+    }
+
+    /**
+     * @brief Pakuje blok A (mc×kc) do paneli po MR wierszy
+     * @details Panel zawiera kolejne kolumny bloku, po MR elementów każda;
+     * brakujące wiersze ostatniego panelu uzupełniane są zerami.
+     */
+    void pakuj_a(const int* a, int lda, int mc, int kc, int* bufor) {
+        for (int ir = 0; ir < mc; ir += MR) {
+            int mr = std::min(MR, mc - ir);
+            for (int p = 0; p < kc; ++p) {
+                for (int i = 0; i < mr; ++i) bufor[i] = a[(ir + i) * lda + p];
+                for (int i = mr; i < MR; ++i) bufor[i] = 0;
+                bufor += MR;
+            }
+        }
+    }
+
+    /**
+     * @brief Pakuje blok B (kc×nc) do paneli po NR kolumn
+     * @details Panel zawiera kolejne wiersze bloku, po NR elementów każdy;
+     * brakujące kolumny ostatniego panelu uzupełniane są zerami.
+     */
+    void pakuj_b(const int* b, int ldb, int kc, int nc, int* bufor) {
+        for (int jr = 0; jr < nc; jr += NR) {
+            int nr = std::min(NR, nc - jr);
+            for (int p = 0; p < kc; ++p) {
+                const int* wiersz = b + p * ldb + jr;
+                for (int j = 0; j < nr; ++j) bufor[j] = wiersz[j];
+                for (int j = nr; j < NR; ++j) bufor[j] = 0;
+                bufor += NR;
+            }
+        }
+    }
+
+    /**
+     * @brief Mikrojądro MR×NR: C[mr×nr] += panel A * panel B
+     * @details Sumy częściowe czterech wierszy trzymane są w tablicach c0..c3,
+     * które kompilator umieszcza w rejestrach wektorowych. Liczone są bez
+     * znaku (modulo 2^32), więc przepełnienia nie są zachowaniem niezdefiniowanym.
+     */
+    MATRIX_KLONY_SIMD
+    void mikrojadro(int kc, const int* ap, const int* bp, int* c, int ldc, int mr, int nr) {
+        static_assert(MR == 4, "mikrojadro zaklada MR == 4");
+        unsigned c0[NR] = {}, c1[NR] = {}, c2[NR] = {}, c3[NR] = {};
+        for (int p = 0; p < kc; ++p) {
+            unsigned a0 = ap[0], a1 = ap[1], a2 = ap[2], a3 = ap[3];
+            for (int j = 0; j < NR; ++j) {
+                unsigned bv = static_cast<unsigned>(bp[j]);
+                c0[j] += a0 * bv;
+                c1[j] += a1 * bv;
+                c2[j] += a2 * bv;
+                c3[j] += a3 * bv;
+            }
+            ap += MR;
+            bp += NR;
+        }
+        const unsigned* acc[MR] = { c0, c1, c2, c3 };
+        for (int i = 0; i < mr; ++i)
+            for (int j = 0; j < nr; ++j)
+                c[i * ldc + j] = static_cast<int>(static_cast<unsigned>(c[i * ldc + j]) + acc[i][j]);
+    }
+
+    /**
+     * @brief Liczy C = A * B algorytmem blokowym dla bloków z dowolnym krokiem wiersza
+     * @details C (m×n) jest zerowana, a następnie akumulowana blokami KC iloczynu
+     * A (m×k) i B (k×n). Bufory pakowania należą do wywołującego
+     * (ROZMIAR_BUFORA_A i ROZMIAR_BUFORA_B elementów).
+     */
+    void blokowe_kafel(const int* a, int lda, const int* b, int ldb, int* c, int ldc,
+        int m, int n, int k, int* bufor_a, int* bufor_b) {
+        for (int i = 0; i < m; ++i)
+            std::fill(c + i * ldc, c + i * ldc + n, 0);
+
+        for (int jc = 0; jc < n; jc += NC) {
+            int nc = std::min(NC, n - jc);
+            for (int pc = 0; pc < k; pc += KC) {
+                int kc = std::min(KC, k - pc);
+                pakuj_b(b + pc * ldb + jc, ldb, kc, nc, bufor_b);
+                for (int ic = 0; ic < m; ic += MC) {
+                    int mc = std::min(MC, m - ic);
+                    pakuj_a(a + ic * lda + pc, lda, mc, kc, bufor_a);
+                    for (int jr = 0; jr < nc; jr += NR) {
+                        for (int ir = 0; ir < mc; ir += MR) {
+                            mikrojadro(kc, bufor_a + ir * kc, bufor_b + jr * kc,
+                                c + (ic + ir) * ldc + jc + jr, ldc,
+                                std::min(MR, mc - ir), std::min(NR, nc - jr));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Dzieli wynik n×n na kafle wierszy i kolumn i wykonuje kafel(r0, m, k0, szerokosc) w puli wątków
+     * @details Kafle wierszy mają wysokość MC; gdy jest ich za mało na wszystkie
+     * wątki, wynik dzielony jest dodatkowo na kafle kolumn (wielokrotność NR).
+     */
+    void kafelkami(int n, int watkow, const std::function<void(int, int, int, int)>& kafel) {
+        int kafle_wierszy = (n + MC - 1) / MC;
+        int kafle_kolumn = (2 * watkow + kafle_wierszy - 1) / kafle_wierszy;
+        kafle_kolumn = std::max(1, std::min(kafle_kolumn, n / MIN_KAFEL_KOLUMN));
+        int szerokosc = (n + kafle_kolumn - 1) / kafle_kolumn;
+        szerokosc = (szerokosc + NR - 1) / NR * NR;
+        kafle_kolumn = (n + szerokosc - 1) / szerokosc;
+
+        watki::globalna()->rownolegle_dla(kafle_wierszy * kafle_kolumn, [&](int zadanie) {
+            int r0 = (zadanie / kafle_kolumn) * MC;
+            int k0 = (zadanie % kafle_kolumn) * szerokosc;
+            kafel(r0, std::min(MC, n - r0), k0, std::min(szerokosc, n - k0));
+        });
+    }
+
+    // ==================== Akumulacja 64-bitowa ====================
+
+    /**
+     * @brief Mikrojądro MR×NR z 64-bitowymi sumami: C[mr×nr] += panel A * panel B
+     * @details Panele są te same co w mikrojadro(). Liczy je ręczne jądro
+     * simd::, bo kompilator składa iloczyn 64-bitowy z trzech mnożeń zamiast
+     * jednego mnożenia 32×32→64 ze znakiem. Kafle brzegowe liczone są
+     * w buforze i dodawane częściowo. Wywołujący gwarantuje, że żadna suma
+     * nie przepełni int64.
+     */
+    void mikrojadro_64(simd::jadro_iloczynow_4x16 jadro, int kc, const int* ap, const int* bp,
+        std::int64_t* c, int ldc, int mr, int nr) {
+        static_assert(MR == 4 && NR == 16, "mikrojadro_64 zaklada kafel 4x16");
+        if (mr == MR && nr == NR) {
+            jadro(kc, ap, bp, c, ldc);
+            return;
+        }
+        std::int64_t kafel[MR * NR] = {};
+        jadro(kc, ap, bp, kafel, NR);
+        for (int i = 0; i < mr; ++i)
+            for (int j = 0; j < nr; ++j)
+                c[i * ldc + j] += kafel[i * NR + j];
+    }
+
+    /**
+     * @brief Liczy sumy 64-bitowe kafla C (m×w, m <= MC) iloczynu A (m×k) i B (k×w)
+     * @details Blokowanie i pakowanie jak w blokowe_kafel(); sumy zbierane są
+     * w buforze wątku o kroku w, a zwężane do int przez wywołującego.
+     * @return Bufor m*w sum (ważny do następnego wywołania w tym wątku)
+     */
+    const std::int64_t* sumy_64_kafel(const int* a, int lda, const int* b, int ldb, int m, int w, int k) {
+        thread_local std::vector<std::int64_t> sumy;
+        sumy.assign(static_cast<std::size_t>(m) * w, 0);
+        bufory_pakowania& bufory = bufory_watku();
+        simd::jadro_iloczynow_4x16 jadro = simd::iloczyny_4x16_64();
+        for (int jc = 0; jc < w; jc += NC) {
+            int nc = std::min(NC, w - jc);
+            for (int pc = 0; pc < k; pc += KC) {
+                int kc = std::min(KC, k - pc);
+                pakuj_b(b + pc * ldb + jc, ldb, kc, nc, bufory.b.data());
+                pakuj_a(a + pc, lda, m, kc, bufory.a.data());
+                for (int jr = 0; jr < nc; jr += NR) {
+                    for (int ir = 0; ir < m; ir += MR) {
+                        mikrojadro_64(jadro, kc, bufory.a.data() + ir * kc, bufory.b.data() + jr * kc,
+                            sumy.data() + static_cast<std::size_t>(ir) * w + jc + jr, w,
+                            std::min(MR, m - ir), std::min(NR, nc - jr));
+                    }
+                }
+            }
+        }
+        return sumy.data();
+    }
+
+    constexpr int PAS_SZEROKI = 8; ///< Wiersze wyniku liczone razem (wiersz B czytany raz na pas)
+
+    /**
+     * @brief Wykonuje pas(r0, r1) dla kolejnych pasów PAS_SZEROKI wierszy, w puli wątków dla dużych n
+     */
+    void pasami(int n, const std::function<void(int, int)>& pas) {
+        int pasy = (n + PAS_SZEROKI - 1) / PAS_SZEROKI;
+        auto licz = [&](int p) {
+            int r0 = p * PAS_SZEROKI;
+            pas(r0, std::min(n, r0 + PAS_SZEROKI));
+        };
+        std::shared_ptr<watki::pula_watkow> pula = watki::globalna();
+        if (n < PROG_ROWNOLEGLY || pula->liczba_watkow() == 1) {
+            for (int p = 0; p < pasy; ++p) licz(p);
+            return;
+        }
+        pula->rownolegle_dla(pasy, licz);
+    }
+
+    /**
+     * @brief suma[j] += a * b[j] dla j = 0..n-1 (b traktowane jako liczby bez znaku)
+     * @details Jądro trybu modulo i nasycanego z przenoszeniem 128-bitowym nie
+     * ma wariantów simd::; pętlę wektoryzuje kompilator w klonach MATRIX_KLONY_SIMD.
+     */
+    MATRIX_KLONY_SIMD
+    void dodaj_iloczyny(std::uint64_t* suma, std::uint64_t a, const int* b, int n) {
+        for (int j = 0; j < n; ++j) suma[j] += a * static_cast<std::uint32_t>(b[j]);
+    }
+
+    /**
+     * @brief suma[j] += a * b[j] dla j = 0..n-1 (ze znakiem)
+     */
+    MATRIX_KLONY_SIMD
+    void dodaj_iloczyny(std::int64_t* suma, std::int64_t a, const int* b, int n) {
+        for (int j = 0; j < n; ++j) suma[j] += a * static_cast<std::int64_t>(b[j]);
+    }
+
+    /**
+     * @brief Zwraca największą wartość bezwzględną elementu bufora
+     */
+    std::uint64_t najwiekszy_modul(const int* a, std::size_t ile) {
+        std::uint64_t wynik = 0;
+        for (std::size_t i = 0; i < ile; ++i) {
+            std::int64_t x = a[i];
+            wynik = std::max(wynik, static_cast<std::uint64_t>(x < 0 ? -x : x));
+        }
+        return wynik;
+    }
+
+    /**
+     * @brief Liczba składników o module <= iloczyn, które można dodać do sumy o module <= start bez przekroczenia limitu
+     * @return Wynik ograniczony do [1, n]
+     */
+    int bezpieczny_okres(std::uint64_t limit, std::uint64_t start, std::uint64_t iloczyn, int n) {
+        std::uint64_t okres = iloczyn == 0 ? std::uint64_t(n) : (limit - start) / iloczyn;
+        return static_cast<int>(std::clamp<std::uint64_t>(okres, 1, std::uint64_t(std::max(n, 1))));
+    }
+
+    /**
+     * @brief Górne 64 bity iloczynu x * y
+     * @details Składane z czterech iloczynów 32×32 bitów, bez niestandardowego
+     * typu __int128.
+     */
+    std::uint64_t gorne_64(std::uint64_t x, std::uint64_t y) {
+        std::uint64_t x0 = x & 0xFFFFFFFFu, x1 = x >> 32;
+        std::uint64_t y0 = y & 0xFFFFFFFFu, y1 = y >> 32;
+        std::uint64_t p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+        std::uint64_t srodek = (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+        return p11 + (p01 >> 32) + (p10 >> 32) + (srodek >> 32);
+    }
+
+    /**
+     * @struct barrett
+     * @brief Redukcja x mod m (m < 2^31) mnożeniem przez odwrotność zamiast dzielenia
+     * @details q = górne 64 bity x * floor((2^64 - 1) / m) różni się od
+     * floor(x / m) o co najwyżej 2, więc reszta wymaga najwyżej dwóch odejmowań.
+     */
+    struct barrett {
+        std::uint64_t m;        ///< Moduł
+        std::uint64_t odwrotna; ///< floor((2^64 - 1) / m)
+
+        explicit barrett(std::uint64_t m) : m(m), odwrotna(std::numeric_limits<std::uint64_t>::max() / m) {}
+
+        std::uint64_t operator()(std::uint64_t x) const {
+            std::uint64_t q = gorne_64(x, odwrotna);
+            std::uint64_t r = x - q * m;
+            if (r >= m) r -= m;
+            if (r >= m) r -= m;
+            return r;
+        }
+    };
+
+    /**
+     * @brief Liczy pas wierszy [r0, r1) iloczynu modulo
+     * @param okres Liczba składników, po których akumulatory trzeba zredukować
+     */
+    void modulo_pas(const int* a, const int* b, int* c, int n, const barrett& redukcja, int r0, int r1, int okres) {
+        thread_local std::vector<std::uint64_t> sumy;
+        int wierszy = r1 - r0;
+        sumy.assign(static_cast<std::size_t>(wierszy) * n, 0);
+        int od_redukcji = 0;
+        for (int k = 0; k < n; ++k) {
+            if (od_redukcji == okres) {
+                for (std::uint64_t& s : sumy) s = redukcja(s);
+                od_redukcji = 0;
+            }
+            ++od_redukcji;
+            for (int r = 0; r < wierszy; ++r) {
+                int aik = a[(r0 + r) * n + k];
+                if (aik != 0) dodaj_iloczyny(sumy.data() + static_cast<std::size_t>(r) * n, static_cast<std::uint32_t>(aik), b + k * n, n);
+            }
+        }
+        for (int r = 0; r < wierszy; ++r)
+            for (int j = 0; j < n; ++j)
+                c[(r0 + r) * n + j] = static_cast<int>(redukcja(sumy[static_cast<std::size_t>(r) * n + j]));
+    }
+
+    /**
+     * @struct suma_128
+     * @brief Dokładna suma liczb 64-bitowych: wysoka * 2^64 + niska
+     */
+    struct suma_128 {
+        std::int64_t wysoka = 0;  ///< Starsze słowo (ze znakiem)
+        std::uint64_t niska = 0;  ///< Młodsze słowo
+
+        void dodaj(std::int64_t x) {
+            std::uint64_t nowa = niska + static_cast<std::uint64_t>(x);
+            wysoka += (nowa < niska ? 1 : 0) - (x < 0 ? 1 : 0);
+            niska = nowa;
+        }
+
+        /// Czy wartość mieści się w int64
+        bool w_64() const {
+            return wysoka == (static_cast<std::int64_t>(niska) < 0 ? -1 : 0);
+        }
+    };
+
+    /**
+     * @brief Zapisuje sumę do int z nasyceniem
+     * @return true, jeśli suma mieściła się w int
+     */
+    bool zwez(std::int64_t suma, int& wynik) {
+        if (suma > std::numeric_limits<int>::max()) {
+            wynik = std::numeric_limits<int>::max();
+            return false;
+        }
+        if (suma < std::numeric_limits<int>::min()) {
+            wynik = std::numeric_limits<int>::min();
+            return false;
+        }
+        wynik = static_cast<int>(suma);
+        return true;
+    }
+
+    /**
+     * @brief Liczy pas wierszy [r0, r1) iloczynu z nasyceniem
+     * @param okres Liczba składników, po których sumy 64-bitowe przenoszone są do 128-bitowych
+     * @return true, jeśli wszystkie elementy pasa zmieściły się w int
+     */
+    bool nasycone_pas(const int* a, const int* b, int* c, int n, int r0, int r1, int okres) {
+        thread_local std::vector<std::int64_t> sumy;
+        thread_local std::vector<suma_128> duze;
+        int wierszy = r1 - r0;
+        std::size_t ile = static_cast<std::size_t>(wierszy) * n;
+        sumy.assign(ile, 0);
+        bool przenoszenie = okres < n;
+        if (przenoszenie) duze.assign(ile, suma_128{});
+
+        int od_przeniesienia = 0;
+        for (int k = 0; k < n; ++k) {
+            if (od_przeniesienia == okres) {
+                for (std::size_t i = 0; i < ile; ++i) {
+                    duze[i].dodaj(sumy[i]);
+                    sumy[i] = 0;
+                }
+                od_przeniesienia = 0;
+            }
+            ++od_przeniesienia;
+            for (int r = 0; r < wierszy; ++r) {
+                int aik = a[(r0 + r) * n + k];
+                if (aik != 0) dodaj_iloczyny(sumy.data() + static_cast<std::size_t>(r) * n, static_cast<std::int64_t>(aik), b + k * n, n);
+            }
+        }
+
+        bool miesci = true;
+        int* wynik = c + static_cast<std::size_t>(r0) * n;
+        for (std::size_t i = 0; i < ile; ++i) {
+            if (!przenoszenie) {
+                miesci &= zwez(sumy[i], wynik[i]);
+                continue;
+            }
+            duze[i].dodaj(sumy[i]);
+            if (duze[i].w_64()) miesci &= zwez(static_cast<std::int64_t>(duze[i].niska), wynik[i]);
+            else {
+                wynik[i] = duze[i].wysoka < 0 ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max();
+                miesci = false;
+            }
+        }
+        return miesci;
+    }
+
+    // ==================== Strassen-Winograd ====================
+
+    /**
+     * @brief Z = X + Y dla bloków h×h
+     * @details Sumy liczone są w arytmetyce bez znaku (modulo 2^32), więc
+     * przepełnienia pośrednich sum nie zmieniają końcowego wyniku.
+     */
+    MATRIX_KLONY_SIMD
+    void dodaj(const int* x, int ldx, const int* y, int ldy, int* z, int ldz, int h) {
+        for (int i = 0; i < h; ++i)
+            for (int j = 0; j < h; ++j)
+                z[i * ldz + j] = static_cast<int>(static_cast<unsigned>(x[i * ldx + j]) + static_cast<unsigned>(y[i * ldy + j]));
+    }
+
+    /**
+     * @brief Z = X - Y dla bloków h×h (arytmetyka modulo 2^32)
+     */
+    MATRIX_KLONY_SIMD
+    void odejmij(const int* x, int ldx, const int* y, int ldy, int* z, int ldz, int h) {
+        for (int i = 0; i < h; ++i)
+            for (int j = 0; j < h; ++j)
+                z[i * ldz + j] = static_cast<int>(static_cast<unsigned>(x[i * ldx + j]) - static_cast<unsigned>(y[i * ldy + j]));
+    }
+
+    /**
+     * @brief Rekurencja Strassena-Winograda: C (n×n) = A * B
+     * @details Poniżej progu (lub dla n <= 1) używane jest jądro blokowe.
+     * Nieparzyste n obsługiwane jest przez odcięcie ostatniego wiersza
+     * i kolumny: część (n-1)×(n-1) liczona jest rekurencyjnie, a brakujące
+     * elementy poprawką O(n^2).
+     * @param rownolegle Czy siedem iloczynów tego poziomu liczyć w puli wątków
+     */
+    void strassen_rek(const int* a, int lda, const int* b, int ldb, int* c, int ldc,
+        int n, int prog, bool rownolegle) {
+        if (n <= prog || n <= 1) {
+            bufory_pakowania& bufory = bufory_watku();
+            blokowe_kafel(a, lda, b, ldb, c, ldc, n, n, n, bufory.a.data(), bufory.b.data());
+            return;
+        }
+
+        if (n % 2 != 0) {
+            int m = n - 1;
+            strassen_rek(a, lda, b, ldb, c, ldc, m, prog, rownolegle);
+            const unsigned* bm = reinterpret_cast<const unsigned*>(b + m * ldb);
+            // C11 += a12 * b21 (poprawka rzędu 1)
+            for (int i = 0; i < m; ++i) {
+                unsigned ai = static_cast<unsigned>(a[i * lda + m]);
+                unsigned* ci = reinterpret_cast<unsigned*>(c + i * ldc);
+                for (int j = 0; j < m; ++j) ci[j] += ai * bm[j];
+            }
+            // Ostatni wiersz C
+            unsigned* cm = reinterpret_cast<unsigned*>(c + m * ldc);
+            for (int j = 0; j < n; ++j) cm[j] = 0;
+            for (int k = 0; k < n; ++k) {
+                unsigned ak = static_cast<unsigned>(a[m * lda + k]);
+                const unsigned* bk = reinterpret_cast<const unsigned*>(b + k * ldb);
+                for (int j = 0; j < n; ++j) cm[j] += ak * bk[j];
+            }
+            // Ostatnia kolumna C (bez elementu z ostatniego wiersza)
+            for (int i = 0; i < m; ++i) {
+                unsigned suma = 0;
+                for (int k = 0; k < n; ++k)
+                    suma += static_cast<unsigned>(a[i * lda + k]) * static_cast<unsigned>(b[k * ldb + m]);
+                c[i * ldc + m] = static_cast<int>(suma);
+            }
+            return;
+        }
+
+        int h = n / 2;
+        const int* a11 = a;
+        const int* a12 = a + h;
+        const int* a21 = a + h * lda;
+        const int* a22 = a21 + h;
+        const int* b11 = b;
+        const int* b12 = b + h;
+        const int* b21 = b + h * ldb;
+        const int* b22 = b21 + h;
+        int* c11 = c;
+        int* c12 = c + h;
+        int* c21 = c + h * ldc;
+        int* c22 = c21 + h;
+
+        std::size_t blok = static_cast<std::size_t>(h) * h;
+        std::unique_ptr<int[]> tymczasowe(new int[15 * blok]);
+        int* s[4];
+        int* t[4];
+        int* mm[7];
+        for (int i = 0; i < 4; ++i) s[i] = tymczasowe.get() + i * blok;
+        for (int i = 0; i < 4; ++i) t[i] = tymczasowe.get() + (4 + i) * blok;
+        for (int i = 0; i < 7; ++i) mm[i] = tymczasowe.get() + (8 + i) * blok;
+
+        dodaj(a21, lda, a22, lda, s[0], h, h);     // S1 = A21 + A22
+        odejmij(s[0], h, a11, lda, s[1], h, h);    // S2 = S1 - A11
+        odejmij(a11, lda, a21, lda, s[2], h, h);   // S3 = A11 - A21
+        odejmij(a12, lda, s[1], h, s[3], h, h);    // S4 = A12 - S2
+        odejmij(b12, ldb, b11, ldb, t[0], h, h);   // T1 = B12 - B11
+        odejmij(b22, ldb, t[0], h, t[1], h, h);    // T2 = B22 - T1
+        odejmij(b22, ldb, b12, ldb, t[2], h, h);   // T3 = B22 - B12
+        odejmij(t[1], h, b21, ldb, t[3], h, h);    // T4 = T2 - B21
+
+        struct iloczyn {
+            const int* x;
+            int ldx;
+            const int* y;
+            int ldy;
+        };
+        const iloczyn iloczyny[7] = {
+            { a11, lda, b11, ldb },   // M1 = A11 * B11
+            { a12, lda, b21, ldb },   // M2 = A12 * B21
+            { s[3], h, b22, ldb },    // M3 = S4 * B22
+            { a22, lda, t[3], h },    // M4 = A22 * T4
+            { s[0], h, t[0], h },     // M5 = S1 * T1
+            { s[1], h, t[1], h },     // M6 = S2 * T2
+            { s[2], h, t[2], h },     // M7 = S3 * T3
+        };
+        auto licz = [&](int i) {
+            strassen_rek(iloczyny[i].x, iloczyny[i].ldx, iloczyny[i].y, iloczyny[i].ldy, mm[i], h, h, prog, false);
+        };
+        if (rownolegle) watki::globalna()->rownolegle_dla(7, licz);
+        else for (int i = 0; i < 7; ++i) licz(i);
+
+        dodaj(mm[0], h, mm[1], h, c11, ldc, h);    // C11 = M1 + M2
+        dodaj(mm[0], h, mm[5], h, mm[5], h, h);    // U2 = M1 + M6
+        dodaj(mm[5], h, mm[6], h, mm[6], h, h);    // U3 = U2 + M7
+        dodaj(mm[5], h, mm[4], h, mm[5], h, h);    // U4 = U2 + M5
+        dodaj(mm[5], h, mm[2], h, c12, ldc, h);    // C12 = U4 + M3
+        odejmij(mm[6], h, mm[3], h, c21, ldc, h);  // C21 = U3 - M4
+        dodaj(mm[6], h, mm[4], h, c22, ldc, h);    // C22 = U3 + M5
+    }
+}
+
+namespace mnozenie {
+
+    void naiwne(const int* a, const int* b, int* c, int n) {
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                unsigned suma = 0;
+                for (int k = 0; k < n; ++k) {
+                    suma += static_cast<unsigned>(a[i * n + k]) * static_cast<unsigned>(b[k * n + j]);
+                }
+                c[i * n + j] = static_cast<int>(suma);
+            }
+        }
+    }
+
+    void blokowe(const int* a, const int* b, int* c, int n) {
+        bufory_pakowania& bufory = bufory_watku();
+        blokowe_kafel(a, n, b, n, c, n, n, n, n, bufory.a.data(), bufory.b.data());
+    }
+
+    void blokowe_rownolegle(const int* a, const int* b, int* c, int n) {
+        std::shared_ptr<watki::pula_watkow> pula = watki::globalna();
+        int watkow = pula->liczba_watkow();
+        if (n < PROG_ROWNOLEGLY || watkow == 1) {
+            blokowe(a, b, c, n);
+            return;
+        }
+
+        kafelkami(n, watkow, [&](int r0, int m, int k0, int szerokosc) {
+            bufory_pakowania& bufory = bufory_watku();
+            blokowe_kafel(a + r0 * n, n, b + k0, n, c + r0 * n + k0, n, m, szerokosc, n,
+                bufory.a.data(), bufory.b.data());
+        });
+    }
+
+    void strassen(const int* a, const int* b, int* c, int n, int prog) {
+        strassen_rek(a, n, b, n, c, n, n, prog, watki::globalna()->liczba_watkow() > 1);
+    }
+
+    bool nasycone(const int* a, const int* b, int* c, int n) {
+        // |iloczyn| <= max|A| * max|B| <= 2^62; po przeniesieniu suma 64-bitowa jest zerowa
+        std::size_t ile = static_cast<std::size_t>(n) * n;
+        std::uint64_t max_iloczyn = najwiekszy_modul(a, ile) * najwiekszy_modul(b, ile);
+        int okres = bezpieczny_okres(std::numeric_limits<std::int64_t>::max(), 0, max_iloczyn, n);
+        std::atomic<bool> miesci{ true };
+        if (okres == n) {
+            // Żadna suma n składników nie przepełni int64: wystarczy mikrojądro blokowe
+            auto kafel = [&](int r0, int m, int k0, int szerokosc) {
+                const std::int64_t* sumy = sumy_64_kafel(a + r0 * n, n, b + k0, n, m, szerokosc, n);
+                bool w_zakresie = true;
+                for (int i = 0; i < m; ++i)
+                    for (int j = 0; j < szerokosc; ++j)
+                        w_zakresie &= zwez(sumy[static_cast<std::size_t>(i) * szerokosc + j], c[(r0 + i) * n + k0 + j]);
+                if (!w_zakresie) miesci.store(false, std::memory_order_relaxed);
+            };
+            int watkow = watki::globalna()->liczba_watkow();
+            if (n < PROG_ROWNOLEGLY || watkow == 1)
+                for (int r0 = 0; r0 < n; r0 += MC) kafel(r0, std::min(MC, n - r0), 0, n);
+            else kafelkami(n, watkow, kafel);
+            return miesci.load(std::memory_order_relaxed);
+        }
+        pasami(n, [&](int r0, int r1) {
+            if (!nasycone_pas(a, b, c, n, r0, r1, okres)) miesci.store(false, std::memory_order_relaxed);
+        });
+        return miesci.load(std::memory_order_relaxed);
+    }
+
+    void modulo(const int* a, const int* b, int* c, int n, int modul) {
+        // Po redukcji akumulator jest < modul, a każdy składnik <= (modul-1)^2
+        std::uint64_t m = static_cast<std::uint64_t>(modul);
+        int okres = bezpieczny_okres(std::numeric_limits<std::uint64_t>::max(), m - 1, (m - 1) * (m - 1), n);
+        barrett redukcja(m);
+        pasami(n, [&](int r0, int r1) { modulo_pas(a, b, c, n, redukcja, r0, r1, okres); });
+    }
+}
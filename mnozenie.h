@@ -0,0 +1,99 @@
+#ifndef MNOZENIE_H
+#define MNOZENIE_H
+
+/**
+ * @file mnozenie.h
+ * @brief Jądra mnożenia macierzowego działające na surowych buforach
+ *
+ * Funkcje operują na kwadratowych macierzach n×n przechowywanych wierszami
+ * (tak jak macierz_ptr w klasie matrix). Nie są częścią publicznego API —
+ * korzysta z nich implementacja operator* w matrix.cpp.
+ */
+
+namespace mnozenie {
+
+    /**
+     * @brief Referencyjne mnożenie i-j-k (C = A * B)
+     * @details Najprostsza implementacja, używana do weryfikacji szybszych jąder
+     * @param a Bufor macierzy A (n*n elementów)
+     * @param b Bufor macierzy B (n*n elementów)
+     * @param c Bufor wynikowy C (n*n elementów, nadpisywany)
+     * @param n Rozmiar macierzy
+     */
+    void naiwne(const int* a, const int* b, int* c, int n);
+
+    /**
+     * @brief Blokowane mnożenie z pakowaniem i mikrojądrem rejestrowym (C = A * B)
+     * @details Macierze dzielone są na bloki mieszczące się w L1/L2/L3,
+     * bloki A i B pakowane są do ciągłych paneli, a wynik liczy mikrojądro
+     * MR×NR trzymające sumy częściowe w rejestrach.
+     * @param a Bufor macierzy A (n*n elementów)
+     * @param b Bufor macierzy B (n*n elementów)
+     * @param c Bufor wynikowy C (n*n elementów, nadpisywany)
+     * @param n Rozmiar macierzy
+     */
+    void blokowe(const int* a, const int* b, int* c, int n);
+
+    /**
+     * @brief Wielowątkowe mnożenie blokowe (C = A * B)
+     * @details Macierz wynikowa dzielona jest na kafle wierszy/kolumn liczone
+     * przez globalną pulę wątków. Dla małych n oraz przy jednym wątku
+     * wykonywane jest zwykłe mnożenie blokowe w wątku wywołującym.
+     * @param a Bufor macierzy A (n*n elementów)
+     * @param b Bufor macierzy B (n*n elementów)
+     * @param c Bufor wynikowy C (n*n elementów, nadpisywany)
+     * @param n Rozmiar macierzy
+     */
+    void blokowe_rownolegle(const int* a, const int* b, int* c, int n);
+
+    /**
+     * @brief Mnożenie Strassena-Winograda (C = A * B)
+     * @details Rekurencja z 7 mnożeniami i 15 dodawaniami na poziom; bloki
+     * nie większe niż prog liczone są jądrem blokowym. Nieparzyste rozmiary
+     * obsługiwane są przez odcięcie ostatniego wiersza i kolumny. Siedem
+     * iloczynów najwyższego poziomu liczonych jest w puli wątków.
+     * @param a Bufor macierzy A (n*n elementów)
+     * @param b Bufor macierzy B (n*n elementów)
+     * @param c Bufor wynikowy C (n*n elementów, nadpisywany)
+     * @param n Rozmiar macierzy
+     * @param prog Rozmiar, poniżej którego rekurencja przechodzi na jądro blokowe
+     */
+    void strassen(const int* a, const int* b, int* c, int n, int prog);
+
+    /**
+     * @brief Mnożenie z 64-bitową akumulacją i nasyceniem wyniku (C = A * B)
+     * @details Sumy liczone są dokładnie. Gdy n iloczynów nie może przepełnić
+     * 64 bitów (zawsze przy |elementach| < 2^31 / sqrt(n)), wynik liczy
+     * blokowanie i pakowanie z blokowe() z mikrojądrem simd::iloczyny_4x16_64()
+     * na 64-bitowych sumach, w kaflach rozdzielanych jak w blokowe_rownolegle().
+     * Kosztuje to około 1,1× czasu trybu zawijania przy AVX-512 i 1,7× przy
+     * AVX2 (n = 512–1024), bo rejestr mieści o połowę mniej sum. W przeciwnym
+     * razie wiersze liczone są pasami w puli wątków, z przenoszeniem do sum
+     * 128-bitowych co kilka składników (przy elementach bliskich INT_MAX do
+     * około 10× czasu zawijania).
+     * Elementy spoza zakresu int zapisywane są jako INT_MIN lub INT_MAX.
+     * @param a Bufor macierzy A (n*n elementów)
+     * @param b Bufor macierzy B (n*n elementów)
+     * @param c Bufor wynikowy C (n*n elementów, nadpisywany)
+     * @param n Rozmiar macierzy
+     * @return true, jeśli wszystkie elementy wyniku zmieściły się w int
+     */
+    bool nasycone(const int* a, const int* b, int* c, int n);
+
+    /**
+     * @brief Mnożenie modulo (C = A * B mod modul)
+     * @details Iloczyny sumowane są w 64-bitowych akumulatorach, redukowanych
+     * (redukcją Barretta) dopiero wtedy, gdy kolejny składnik mógłby je
+     * przepełnić. Wiersze wyniku liczone są pasami w globalnej puli wątków.
+     * Tak jak w nasycone(), akumulację wektoryzuje kompilator w wariantach
+     * MATRIX_KLONY_SIMD, a nie ręczne jądra simd::.
+     * @param a Bufor macierzy A (n*n elementów z zakresu [0, modul))
+     * @param b Bufor macierzy B (n*n elementów z zakresu [0, modul))
+     * @param c Bufor wynikowy C (n*n elementów, nadpisywany wartościami z [0, modul))
+     * @param n Rozmiar macierzy
+     * @param modul Moduł (> 0)
+     */
+    void modulo(const int* a, const int* b, int* c, int n, int modul);
+}
+
+#endif
@@ -0,0 +1,338 @@
+/**
+ * @file pakiet_macierzy.cpp
+ * @brief Implementacja pakietu małych macierzy w układzie SoA
+ */
+
+#include "pakiet_macierzy.h"
+#include "simd.h"
+#include "watki.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+namespace {
+
+    constexpr int LINIE = pakiet_macierzy::LINIE;
+    constexpr int KOLUMNY_BLOKU = 4; ///< Kolumny wyniku, których sumy mnożenie trzyma w rejestrach
+
+    /// Minimalna liczba działań na zadanie przy podziale pakietu na wątki
+    constexpr std::size_t PRACA_NA_ZADANIE = std::size_t(1) << 18;
+
+    /**
+     * @brief Sprawdza, czy pakiety mają ten sam rozmiar macierzy i tę samą ich liczbę
+     * @throw std::logic_error Jeśli pakiety są niezgodne
+     */
+    void sprawdz_zgodnosc(int n1, int liczba1, int n2, int liczba2) {
+        if (n1 != n2 || liczba1 != liczba2)
+            throw std::logic_error("Pakiety muszą mieć ten sam rozmiar i liczbę macierzy");
+    }
+
+    /**
+     * @brief Wykonuje zakres(g0, g1) dla przedziałów grup, w puli wątków gdy pracy jest dość
+     * @param grupy Liczba grup
+     * @param praca_grupy Przybliżona liczba działań na grupę
+     * @param zakres Funkcja przetwarzająca grupy [g0, g1)
+     */
+    void dla_grup(int grupy, std::size_t praca_grupy, const std::function<void(int, int)>& zakres) {
+        std::size_t na_zadanie = std::max<std::size_t>(1, PRACA_NA_ZADANIE / std::max<std::size_t>(praca_grupy, 1));
+        int zadania = static_cast<int>((grupy + na_zadanie - 1) / na_zadanie);
+        if (zadania <= 1 || watki::liczba_watkow() == 1) {
+            zakres(0, grupy);
+            return;
+        }
+        watki::globalna()->rownolegle_dla(zadania, [&](int z) {
+            int g0 = static_cast<int>(z * na_zadanie);
+            zakres(g0, std::min(grupy, static_cast<int>(g0 + na_zadanie)));
+        });
+    }
+
+    /**
+     * @brief C = A * B dla jednej grupy LINIE macierzy n×n z przeplotem
+     * @details Pętla po l (macierzach grupy) jest najgłębsza i ma stałą
+     * długość, więc kompilator liczy ją jednym lub kilkoma rejestrami.
+     * Sumy KOLUMNY_BLOKU elementów wiersza wyniku zostają w rejestrach
+     * przez całą pętlę po k, a element A jest wczytywany raz na blok.
+     */
+    MATRIX_KLONY_SIMD
+    void mnoz_grupe(const int* a, const int* b, int* c, int n) {
+        const unsigned* ua = reinterpret_cast<const unsigned*>(a);
+        const unsigned* ub = reinterpret_cast<const unsigned*>(b);
+        unsigned* uc = reinterpret_cast<unsigned*>(c);
+        for (int i = 0; i < n; ++i) {
+            int j0 = 0;
+            for (; j0 + KOLUMNY_BLOKU <= n; j0 += KOLUMNY_BLOKU) {
+                unsigned suma[KOLUMNY_BLOKU][LINIE] = {};
+                for (int k = 0; k < n; ++k) {
+                    const unsigned* aik = ua + (static_cast<std::size_t>(i) * n + k) * LINIE;
+                    const unsigned* bkj = ub + (static_cast<std::size_t>(k) * n + j0) * LINIE;
+                    for (int jj = 0; jj < KOLUMNY_BLOKU; ++jj)
+                        for (int l = 0; l < LINIE; ++l) suma[jj][l] += aik[l] * bkj[jj * LINIE + l];
+                }
+                std::copy(&suma[0][0], &suma[0][0] + KOLUMNY_BLOKU * LINIE, uc + (static_cast<std::size_t>(i) * n + j0) * LINIE);
+            }
+            for (; j0 < n; ++j0) {
+                unsigned suma[LINIE] = {};
+                for (int k = 0; k < n; ++k) {
+                    const unsigned* aik = ua + (static_cast<std::size_t>(i) * n + k) * LINIE;
+                    const unsigned* bkj = ub + (static_cast<std::size_t>(k) * n + j0) * LINIE;
+                    for (int l = 0; l < LINIE; ++l) suma[l] += aik[l] * bkj[l];
+                }
+                std::copy(suma, suma + LINIE, uc + (static_cast<std::size_t>(i) * n + j0) * LINIE);
+            }
+        }
+    }
+}
+
+// ==================== Konstruktory ====================
+
+/**
+ * @brief Konstruktor domyślny - tworzy pusty pakiet
+ */
+pakiet_macierzy::pakiet_macierzy(void) : n(0), liczba(0), grupy(0) {}
+
+/**
+ * @brief Tworzy pakiet liczba zerowych macierzy n×n
+ * @param n Rozmiar macierzy
+ * @param liczba Liczba macierzy w pakiecie
+ * @throw std::logic_error Jeśli n <= 0 lub liczba < 0
+ */
+pakiet_macierzy::pakiet_macierzy(int n, int liczba) : n(n), liczba(liczba), grupy((liczba + LINIE - 1) / LINIE) {
+    if (n <= 0 || liczba < 0) throw std::logic_error("Zly rozmiar pakietu");
+    dane = pamiec::przydziel(elementy());
+    std::fill(dane.get(), dane.get() + elementy(), 0);
+}
+
+/**
+ * @brief Tworzy pakiet z kopii macierzy (przeplatając je w układzie SoA)
+ * @param macierze Macierze o jednakowym rozmiarze
+ * @throw std::logic_error Jeśli macierze mają różne rozmiary
+ */
+pakiet_macierzy::pakiet_macierzy(const std::vector<matrix>& macierze)
+    : pakiet_macierzy(macierze.empty() ? 1 : macierze.front().getSize(), static_cast<int>(macierze.size())) {
+    for (int m = 0; m < liczba; ++m) ustaw(m, macierze[m]);
+}
+
+/**
+ * @brief Konstruktor kopiujący
+ * @param p Pakiet źródłowy
+ */
+pakiet_macierzy::pakiet_macierzy(const pakiet_macierzy& p) : n(p.n), liczba(p.liczba), grupy(p.grupy) {
+    dane = pamiec::przydziel(elementy());
+    std::copy(p.dane.get(), p.dane.get() + elementy(), dane.get());
+}
+
+/**
+ * @brief Konstruktor przenoszący (źródło zostaje pustym pakietem)
+ * @param p Pakiet źródłowy
+ */
+pakiet_macierzy::pakiet_macierzy(pakiet_macierzy&& p) noexcept
+    : n(p.n), liczba(p.liczba), grupy(p.grupy), dane(std::move(p.dane)) {
+    p.n = p.liczba = p.grupy = 0;
+}
+
+/**
+ * @brief Przypisanie kopiujące
+ * @param p Pakiet źródłowy
+ * @return Referencja do bieżącego pakietu
+ */
+pakiet_macierzy& pakiet_macierzy::operator=(const pakiet_macierzy& p) {
+    if (this != &p) *this = pakiet_macierzy(p);
+    return *this;
+}
+
+/**
+ * @brief Przypisanie przenoszące (źródło zostaje pustym pakietem)
+ * @param p Pakiet źródłowy
+ * @return Referencja do bieżącego pakietu
+ */
+pakiet_macierzy& pakiet_macierzy::operator=(pakiet_macierzy&& p) noexcept {
+    if (this != &p) {
+        n = p.n;
+        liczba = p.liczba;
+        grupy = p.grupy;
+        dane = std::move(p.dane);
+        p.n = p.liczba = p.grupy = 0;
+    }
+    return *this;
+}
+
+// ==================== Dostęp ====================
+
+/**
+ * @brief Zwraca indeks elementu (i, j) macierzy m w danych pakietu
+ * @param m Numer macierzy
+ * @param i Indeks wiersza
+ * @param j Indeks kolumny
+ * @return Indeks w buforze dane
+ * @throw std::logic_error Jeśli współrzędne są poza zakresem
+ */
+std::size_t pakiet_macierzy::indeks(int m, int i, int j) const {
+    if (m < 0 || m >= liczba || i < 0 || j < 0 || i >= n || j >= n)
+        throw std::logic_error("Zle wspolrzedne w pakiecie");
+    return (m / LINIE) * rozmiar_grupy() + (static_cast<std::size_t>(i) * n + j) * LINIE + m % LINIE;
+}
+
+/**
+ * @brief Zastępuje macierz m kopią macierzy x
+ * @param m Numer macierzy
+ * @param x Nowa zawartość
+ * @return Referencja do bieżącego pakietu
+ * @throw std::logic_error Jeśli x ma inny rozmiar albo m jest poza zakresem
+ */
+pakiet_macierzy& pakiet_macierzy::ustaw(int m, const matrix& x) {
+    if (x.getSize() != n) throw std::logic_error("Macierz ma inny rozmiar niz pakiet");
+    int* p = dane.get() + indeks(m, 0, 0);
+    const int* z = x.data();
+    for (std::size_t e = 0; e < static_cast<std::size_t>(n) * n; ++e) p[e * LINIE] = z[e];
+    return *this;
+}
+
+/**
+ * @brief Zwraca kopię macierzy m
+ * @param m Numer macierzy
+ * @return Nowa macierz n×n
+ * @throw std::logic_error Jeśli m jest poza zakresem
+ */
+matrix pakiet_macierzy::pobierz(int m) const {
+    const int* p = dane.get() + indeks(m, 0, 0);
+    matrix wynik(n);
+    int* z = wynik.macierz_ptr.get();
+    for (std::size_t e = 0; e < static_cast<std::size_t>(n) * n; ++e) z[e] = p[e * LINIE];
+    return wynik;
+}
+
+/**
+ * @brief Zwraca kopie wszystkich macierzy pakietu
+ * @return Wektor liczba macierzy
+ */
+std::vector<matrix> pakiet_macierzy::na_macierze() const {
+    std::vector<matrix> wynik;
+    wynik.reserve(liczba);
+    for (int m = 0; m < liczba; ++m) wynik.push_back(pobierz(m));
+    return wynik;
+}
+
+/**
+ * @brief Zwraca element (i, j) macierzy m
+ * @throw std::logic_error Jeśli współrzędne są poza zakresem
+ */
+int pakiet_macierzy::pokaz(int m, int i, int j) const {
+    return dane[indeks(m, i, j)];
+}
+
+/**
+ * @brief Ustawia element (i, j) macierzy m
+ * @throw std::logic_error Jeśli współrzędne są poza zakresem
+ */
+void pakiet_macierzy::wstaw(int m, int i, int j, int wartosc) {
+    dane[indeks(m, i, j)] = wartosc;
+}
+
+// ==================== Działania ====================
+
+/**
+ * @brief Dodaje skalar do wszystkich elementów wszystkich macierzy
+ * @param a Skalar
+ * @return Referencja do bieżącego pakietu
+ */
+pakiet_macierzy& pakiet_macierzy::operator+=(int a) {
+    dla_grup(grupy, rozmiar_grupy(), [&](int g0, int g1) {
+        int* p = dane.get() + g0 * rozmiar_grupy();
+        simd::dodaj_skalar(p, p, (g1 - g0) * rozmiar_grupy(), a);
+    });
+    return *this;
+}
+
+/**
+ * @brief Odejmuje skalar od wszystkich elementów wszystkich macierzy
+ * @param a Skalar
+ * @return Referencja do bieżącego pakietu
+ */
+pakiet_macierzy& pakiet_macierzy::operator-=(int a) {
+    dla_grup(grupy, rozmiar_grupy(), [&](int g0, int g1) {
+        int* p = dane.get() + g0 * rozmiar_grupy();
+        simd::odejmij_skalar(p, p, (g1 - g0) * rozmiar_grupy(), a);
+    });
+    return *this;
+}
+
+/**
+ * @brief Mnoży wszystkie elementy wszystkich macierzy przez skalar
+ * @param a Skalar
+ * @return Referencja do bieżącego pakietu
+ */
+pakiet_macierzy& pakiet_macierzy::operator*=(int a) {
+    dla_grup(grupy, rozmiar_grupy(), [&](int g0, int g1) {
+        int* p = dane.get() + g0 * rozmiar_grupy();
+        simd::mnoz_skalar(p, p, (g1 - g0) * rozmiar_grupy(), a);
+    });
+    return *this;
+}
+
+/**
+ * @brief Dodaje odpowiadające sobie macierze pakietu p
+ * @param p Pakiet o tym samym rozmiarze i liczbie macierzy
+ * @return Referencja do bieżącego pakietu
+ * @throw std::logic_error Jeśli pakiety są niezgodne
+ */
+pakiet_macierzy& pakiet_macierzy::operator+=(const pakiet_macierzy& p) {
+    sprawdz_zgodnosc(n, liczba, p.n, p.liczba);
+    dla_grup(grupy, rozmiar_grupy(), [&](int g0, int g1) {
+        std::size_t od = g0 * rozmiar_grupy();
+        simd::dodaj(dane.get() + od, p.dane.get() + od, dane.get() + od, (g1 - g0) * rozmiar_grupy());
+    });
+    return *this;
+}
+
+/**
+ * @brief Transponuje wszystkie macierze (zamienia całe linie elementów (i, j) i (j, i))
+ * @return Referencja do bieżącego pakietu
+ */
+pakiet_macierzy& pakiet_macierzy::odwroc(void) {
+    dla_grup(grupy, rozmiar_grupy(), [&](int g0, int g1) {
+        for (int g = g0; g < g1; ++g) {
+            int* p = dane.get() + g * rozmiar_grupy();
+            for (int i = 0; i < n; ++i)
+                for (int j = i + 1; j < n; ++j) {
+                    int* x = p + (static_cast<std::size_t>(i) * n + j) * LINIE;
+                    int* y = p + (static_cast<std::size_t>(j) * n + i) * LINIE;
+                    std::swap_ranges(x, x + LINIE, y);
+                }
+        }
+    });
+    return *this;
+}
+
+/**
+ * @brief Sprawdza, czy pakiety zawierają te same macierze
+ * @param p Pakiet do porównania
+ * @return true, jeśli rozmiary, liczby i wszystkie macierze są równe
+ */
+bool pakiet_macierzy::operator==(const pakiet_macierzy& p) const {
+    if (n != p.n || liczba != p.liczba) return false;
+    // Linie ostatniej grupy poza liczba nie należą do żadnej macierzy
+    std::size_t pelne = (liczba / LINIE) * rozmiar_grupy();
+    if (!std::equal(dane.get(), dane.get() + pelne, p.dane.get())) return false;
+    for (std::size_t e = pelne; e < elementy(); ++e) {
+        if (static_cast<int>(e % LINIE) < liczba % LINIE && dane[e] != p.dane[e]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Mnoży odpowiadające sobie macierze dwóch pakietów (C[m] = A[m] * B[m])
+ * @param a Lewe czynniki
+ * @param b Prawe czynniki
+ * @return Pakiet iloczynów (modulo 2^32)
+ * @throw std::logic_error Jeśli pakiety są niezgodne
+ */
+pakiet_macierzy operator*(const pakiet_macierzy& a, const pakiet_macierzy& b) {
+    sprawdz_zgodnosc(a.n, a.liczba, b.n, b.liczba);
+    pakiet_macierzy wynik(a.n, a.liczba);
+    std::size_t rozmiar = a.rozmiar_grupy();
+    dla_grup(a.grupy, rozmiar * a.n, [&](int g0, int g1) {
+        for (int g = g0; g < g1; ++g)
+            mnoz_grupe(a.dane.get() + g * rozmiar, b.dane.get() + g * rozmiar, wynik.dane.get() + g * rozmiar, a.n);
+    });
+    return wynik;
+}
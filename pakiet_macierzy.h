@@ -0,0 +1,195 @@
+#ifndef PAKIET_MACIERZY_H
+#define PAKIET_MACIERZY_H
+
+#include "matrix.h"
+#include "pamiec.h"
+#include <vector>
+
+/**
+ * @file pakiet_macierzy.h
+ * @brief Pakiet wielu małych macierzy tego samego rozmiaru w układzie SoA
+ *
+ * Macierze pakietu grupowane są po LINIE sztuk; w grupie element (i, j)
+ * wszystkich LINIE macierzy leży obok siebie, więc jeden rejestr wektorowy
+ * przechowuje ten sam element kolejnych macierzy. Mnożenie, działania ze
+ * skalarem i transpozycja wykonywane są na całych grupach naraz, bez
+ * alokacji i narzutu wywołania na każdą macierz; duże pakiety dzielone
+ * są na wątki. Arytmetyka jest modulo 2^32, tak jak w klasie matrix.
+ */
+
+/**
+ * @class pakiet_macierzy
+ * @brief Zbiór niezależnych macierzy n×n przechowywanych z przeplotem
+ */
+class pakiet_macierzy {
+public:
+    /// Liczba macierzy w grupie (elementy grupy wypełniają rejestr AVX-512)
+    static constexpr int LINIE = 16;
+
+private:
+    int n;               ///< Rozmiar każdej macierzy (n×n)
+    int liczba;          ///< Liczba macierzy w pakiecie
+    int grupy;           ///< Liczba grup po LINIE macierzy (ostatnia uzupełniona zerami)
+    pamiec::bufor dane;  ///< Grupy po n*n*LINIE elementów; element (i, j) macierzy m pod [(i*n + j)*LINIE + m % LINIE]
+
+    /// Liczba elementów jednej grupy
+    std::size_t rozmiar_grupy() const { return static_cast<std::size_t>(n) * n * LINIE; }
+
+    /// Liczba elementów całego pakietu
+    std::size_t elementy() const { return rozmiar_grupy() * grupy; }
+
+    /**
+     * @brief Zwraca indeks elementu (i, j) macierzy m w buforze
+     * @throw std::logic_error Jeśli indeksy są poza zakresem
+     */
+    std::size_t indeks(int m, int i, int j) const;
+
+public:
+    // ==================== Konstruktory ====================
+
+    /**
+     * @brief Konstruktor domyślny - pusty pakiet
+     */
+    pakiet_macierzy(void);
+
+    /**
+     * @brief Konstruktor tworzący pakiet zerowych macierzy
+     * @param n Rozmiar każdej macierzy
+     * @param liczba Liczba macierzy
+     * @throw std::logic_error Jeśli n <= 0 lub liczba < 0
+     */
+    pakiet_macierzy(int n, int liczba);
+
+    /**
+     * @brief Konstruktor pakujący macierze
+     * @param macierze Macierze o tym samym, dodatnim rozmiarze
+     * @throw std::logic_error Jeśli macierze mają różne rozmiary
+     */
+    explicit pakiet_macierzy(const std::vector<matrix>& macierze);
+
+    /**
+     * @brief Konstruktor kopiujący - głęboka kopia pakietu
+     */
+    pakiet_macierzy(const pakiet_macierzy& p);
+
+    /**
+     * @brief Konstruktor przenoszący - źródło staje się pustym pakietem
+     */
+    pakiet_macierzy(pakiet_macierzy&& p) noexcept;
+
+    /**
+     * @brief Przypisanie kopiujące
+     */
+    pakiet_macierzy& operator=(const pakiet_macierzy& p);
+
+    /**
+     * @brief Przypisanie przenoszące
+     */
+    pakiet_macierzy& operator=(pakiet_macierzy&& p) noexcept;
+
+    // ==================== Dostęp ====================
+
+    /**
+     * @brief Zwraca rozmiar macierzy pakietu
+     * @return Rozmiar n
+     */
+    int getSize() const { return n; }
+
+    /**
+     * @brief Zwraca liczbę macierzy w pakiecie
+     */
+    int rozmiar() const { return liczba; }
+
+    /**
+     * @brief Zapisuje macierz na pozycji m
+     * @param m Pozycja w pakiecie
+     * @param x Macierz n×n
+     * @throw std::logic_error Jeśli m jest poza zakresem lub rozmiar x jest inny niż n
+     */
+    pakiet_macierzy& ustaw(int m, const matrix& x);
+
+    /**
+     * @brief Rozpakowuje macierz z pozycji m
+     * @param m Pozycja w pakiecie
+     * @return Kopia macierzy m
+     * @throw std::logic_error Jeśli m jest poza zakresem
+     */
+    matrix pobierz(int m) const;
+
+    /**
+     * @brief Rozpakowuje wszystkie macierze pakietu
+     */
+    std::vector<matrix> na_macierze() const;
+
+    /**
+     * @brief Zwraca element (i, j) macierzy m
+     * @throw std::logic_error Jeśli indeksy są poza zakresem
+     */
+    int pokaz(int m, int i, int j) const;
+
+    /**
+     * @brief Ustawia element (i, j) macierzy m
+     * @throw std::logic_error Jeśli indeksy są poza zakresem
+     */
+    void wstaw(int m, int i, int j, int wartosc);
+
+    // ==================== Działania ====================
+
+    /**
+     * @brief Dodaje skalar do wszystkich elementów wszystkich macierzy
+     */
+    pakiet_macierzy& operator+=(int a);
+
+    /**
+     * @brief Odejmuje skalar od wszystkich elementów wszystkich macierzy
+     */
+    pakiet_macierzy& operator-=(int a);
+
+    /**
+     * @brief Mnoży wszystkie elementy wszystkich macierzy przez skalar
+     */
+    pakiet_macierzy& operator*=(int a);
+
+    /**
+     * @brief Dodaje do każdej macierzy odpowiadającą jej macierz drugiego pakietu
+     * @throw std::logic_error Jeśli pakiety mają różne rozmiary lub liczby macierzy
+     */
+    pakiet_macierzy& operator+=(const pakiet_macierzy& p);
+
+    /**
+     * @brief Transponuje każdą macierz pakietu
+     * @return Referencja do bieżącego pakietu
+     */
+    pakiet_macierzy& odwroc(void);
+
+    /**
+     * @brief Sprawdza, czy pakiety zawierają te same macierze
+     */
+    bool operator==(const pakiet_macierzy& p) const;
+
+    /**
+     * @brief Mnoży macierze parami: C[m] = A[m] * B[m]
+     * @details Jądro przechodzi pętle i-k-j po elementach, a najgłębsza pętla
+     * liczy LINIE macierzy grupy naraz.
+     * @throw std::logic_error Jeśli pakiety mają różne rozmiary lub liczby macierzy
+     */
+    friend pakiet_macierzy operator*(const pakiet_macierzy& a, const pakiet_macierzy& b);
+
+    /**
+     * @brief Dodaje macierze parami: C[m] = A[m] + B[m]
+     * @throw std::logic_error Jeśli pakiety mają różne rozmiary lub liczby macierzy
+     */
+    friend pakiet_macierzy operator+(pakiet_macierzy a, const pakiet_macierzy& b) { return std::move(a += b); }
+
+    /**
+     * @brief Dodaje skalar do każdej macierzy pakietu
+     */
+    friend pakiet_macierzy operator+(pakiet_macierzy a, int x) { return std::move(a += x); }
+
+    /**
+     * @brief Mnoży każdą macierz pakietu przez skalar
+     */
+    friend pakiet_macierzy operator*(pakiet_macierzy a, int x) { return std::move(a *= x); }
+};
+
+#endif
@@ -0,0 +1,230 @@
+/**
+ * @file pamiec.cpp
+ * @brief Implementacja warstwy alokacji buforów macierzy
+ */
+
+#include "pamiec.h"
+#include "pomiary.h"
+#include <atomic>
+#include <new>
+#include <ostream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/resource.h>
+#define MATRIX_POSIX
+#endif
+
+namespace {
+
+    // ==================== Klasy rozmiarów ====================
+    // Każda potęga dwójki od 64 B dzielona jest na 4 klasy
+    // (2^k, 1.25·2^k, 1.5·2^k, 1.75·2^k), więc zaokrąglenie marnuje < 25%.
+
+    constexpr int MIN_POTEGA = 6;                     ///< Najmniejsza klasa: 2^6 = 64 B
+    constexpr int PODKLASY = 4;                       ///< Liczba klas na potęgę dwójki
+    constexpr int KLASY = (64 - MIN_POTEGA) * PODKLASY; ///< Liczba wszystkich klas
+
+    /**
+     * @brief Zaokrągla rozmiar w górę do klasy rozmiaru
+     * @param bajty Żądany rozmiar
+     * @param klasa Indeks klasy (wyjście)
+     * @return Rozmiar klasy w bajtach
+     */
+    std::size_t zaokraglij(std::size_t bajty, int& klasa) {
+        std::size_t minimum = std::size_t(1) << MIN_POTEGA;
+        if (bajty <= minimum) {
+            klasa = 0;
+            return minimum;
+        }
+        int k = 0;
+        while ((bajty >> (k + 1)) != 0) ++k;
+        std::size_t krok = (std::size_t(1) << k) / PODKLASY;
+        std::size_t kroki = (bajty + krok - 1) / krok;
+        std::size_t rozmiar = kroki * krok;
+        if (kroki == 2 * PODKLASY) {
+            ++k;
+            kroki = PODKLASY;
+        }
+        klasa = (k - MIN_POTEGA) * PODKLASY + static_cast<int>(kroki - PODKLASY);
+        return rozmiar;
+    }
+
+    /**
+     * @brief Zwraca rozmiar klasy w bajtach
+     * @param klasa Indeks klasy
+     */
+    std::size_t rozmiar_klasy(int klasa) {
+        int k = klasa / PODKLASY + MIN_POTEGA;
+        std::size_t krok = (std::size_t(1) << k) / PODKLASY;
+        return (PODKLASY + klasa % PODKLASY) * krok;
+    }
+
+    // ==================== Liczniki ====================
+
+    std::atomic<std::uint64_t> licznik_alokacji{ 0 };
+    std::atomic<std::uint64_t> licznik_z_puli{ 0 };
+    std::atomic<std::uint64_t> licznik_z_systemu{ 0 };
+    std::atomic<std::uint64_t> licznik_zwolnien{ 0 };
+    std::atomic<std::uint64_t> licznik_bajtow_zadanych{ 0 };
+    std::atomic<std::uint64_t> licznik_bajtow_systemu{ 0 };
+    std::atomic<std::uint64_t> bledy_stron_bazowe{ 0 };
+
+    std::atomic<bool> pula_wlaczona{ true };
+    std::atomic<std::size_t> limit_puli{ std::size_t(64) << 20 };
+
+    /**
+     * @brief Zwraca liczbę błędów stron procesu od jego uruchomienia
+     */
+    std::uint64_t bledy_stron_procesu() {
+#ifdef MATRIX_POSIX
+        rusage uzycie{};
+        if (getrusage(RUSAGE_SELF, &uzycie) == 0)
+            return static_cast<std::uint64_t>(uzycie.ru_minflt) + static_cast<std::uint64_t>(uzycie.ru_majflt);
+#endif
+        return 0;
+    }
+
+    // ==================== Alokacja systemowa ====================
+
+    int* z_systemu(std::size_t bajty) {
+        licznik_z_systemu.fetch_add(1, std::memory_order_relaxed);
+        licznik_bajtow_systemu.fetch_add(bajty, std::memory_order_relaxed);
+        return static_cast<int*>(::operator new(bajty, std::align_val_t{ pamiec::WYROWNANIE }));
+    }
+
+    void do_systemu(int* p, std::size_t bajty) {
+        ::operator delete(p, bajty, std::align_val_t{ pamiec::WYROWNANIE });
+    }
+
+    // ==================== Pula wątku ====================
+
+    thread_local bool pula_zniszczona = false; ///< Pula wątku została już zniszczona
+
+    /**
+     * @struct pula_watku
+     * @brief Listy wolnych buforów bieżącego wątku, po jednej na klasę rozmiaru
+     */
+    struct pula_watku {
+        std::vector<int*> wolne[KLASY]; ///< Wolne bufory każdej klasy
+        std::size_t bajty = 0;          ///< Łączny rozmiar przechowywanych buforów
+
+        void oproznij() {
+            for (int k = 0; k < KLASY; ++k) {
+                for (int* p : wolne[k]) do_systemu(p, rozmiar_klasy(k));
+                wolne[k].clear();
+            }
+            bajty = 0;
+        }
+
+        ~pula_watku() {
+            oproznij();
+            pula_zniszczona = true;
+        }
+    };
+
+    pula_watku& pula() {
+        thread_local pula_watku p;
+        return p;
+    }
+}
+
+namespace pamiec {
+
+    void zwalniacz::operator()(int* p) const {
+        licznik_zwolnien.fetch_add(1, std::memory_order_relaxed);
+        if (mapowanie) {
+#ifdef MATRIX_POSIX
+            munmap(mapowanie, bajty);
+#endif
+            return;
+        }
+        if (pula_wlaczona.load(std::memory_order_relaxed) && !pula_zniszczona) {
+            pula_watku& w = pula();
+            if (w.bajty + bajty <= limit_puli.load(std::memory_order_relaxed)) {
+                int klasa;
+                zaokraglij(bajty, klasa);
+                w.wolne[klasa].push_back(p);
+                w.bajty += bajty;
+                return;
+            }
+        }
+        do_systemu(p, bajty);
+    }
+
+    bufor przydziel(std::size_t elementy) {
+        if (elementy == 0) return bufor(nullptr, zwalniacz{});
+        std::size_t bajty = elementy * sizeof(int);
+        int klasa;
+        std::size_t rozmiar = zaokraglij(bajty, klasa);
+        licznik_alokacji.fetch_add(1, std::memory_order_relaxed);
+        licznik_bajtow_zadanych.fetch_add(bajty, std::memory_order_relaxed);
+#ifdef MATRIX_POMIARY
+        pomiary::zarejestruj_alokacje(bajty);
+#endif
+
+        if (pula_wlaczona.load(std::memory_order_relaxed) && !pula_zniszczona) {
+            pula_watku& w = pula();
+            if (!w.wolne[klasa].empty()) {
+                int* p = w.wolne[klasa].back();
+                w.wolne[klasa].pop_back();
+                w.bajty -= rozmiar;
+                licznik_z_puli.fetch_add(1, std::memory_order_relaxed);
+                return bufor(p, zwalniacz{ rozmiar });
+            }
+        }
+        return bufor(z_systemu(rozmiar), zwalniacz{ rozmiar });
+    }
+
+    bufor z_mapowania(void* mapowanie, std::size_t dlugosc, std::size_t przesuniecie) {
+        licznik_alokacji.fetch_add(1, std::memory_order_relaxed);
+        int* dane = reinterpret_cast<int*>(static_cast<char*>(mapowanie) + przesuniecie);
+        return bufor(dane, zwalniacz{ dlugosc, mapowanie });
+    }
+
+    void ustaw_pule(bool wlaczona) {
+        pula_wlaczona.store(wlaczona, std::memory_order_relaxed);
+        if (!wlaczona) oproznij_pule();
+    }
+
+    void ustaw_limit_puli(std::size_t bajty) {
+        limit_puli.store(bajty, std::memory_order_relaxed);
+    }
+
+    void oproznij_pule() {
+        if (!pula_zniszczona) pula().oproznij();
+    }
+
+    statystyki pobierz_statystyki() {
+        statystyki s;
+        s.alokacje = licznik_alokacji.load(std::memory_order_relaxed);
+        s.z_puli = licznik_z_puli.load(std::memory_order_relaxed);
+        s.z_systemu = licznik_z_systemu.load(std::memory_order_relaxed);
+        s.zwolnienia = licznik_zwolnien.load(std::memory_order_relaxed);
+        s.bajty_zadane = licznik_bajtow_zadanych.load(std::memory_order_relaxed);
+        s.bajty_systemu = licznik_bajtow_systemu.load(std::memory_order_relaxed);
+        s.bledy_stron = bledy_stron_procesu() - bledy_stron_bazowe.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void zeruj_statystyki() {
+        licznik_alokacji.store(0, std::memory_order_relaxed);
+        licznik_z_puli.store(0, std::memory_order_relaxed);
+        licznik_z_systemu.store(0, std::memory_order_relaxed);
+        licznik_zwolnien.store(0, std::memory_order_relaxed);
+        licznik_bajtow_zadanych.store(0, std::memory_order_relaxed);
+        licznik_bajtow_systemu.store(0, std::memory_order_relaxed);
+        bledy_stron_bazowe.store(bledy_stron_procesu(), std::memory_order_relaxed);
+    }
+
+    std::ostream& operator<<(std::ostream& o, const statystyki& s) {
+        o << "alokacje: " << s.alokacje
+            << " (z puli: " << s.z_puli << ", z systemu: " << s.z_systemu << ")"
+            << ", zwolnienia: " << s.zwolnienia
+            << ", bajty zadane: " << s.bajty_zadane
+            << ", bajty z systemu: " << s.bajty_systemu
+            << ", bledy stron: " << s.bledy_stron;
+        return o;
+    }
+}
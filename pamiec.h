@@ -0,0 +1,114 @@
+#ifndef PAMIEC_H
+#define PAMIEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+
+/**
+ * @file pamiec.h
+ * @brief Warstwa alokacji buforów macierzy: wyrównanie do 64 bajtów i pula buforów
+ *
+ * Każdy bufor macierzy jest wyrównany do granicy linii pamięci podręcznej
+ * (i rejestru AVX-512). Bufory zwalniane przez macierze tymczasowe trafiają
+ * do puli bieżącego wątku, podzielonej na klasy rozmiarów, i są używane
+ * ponownie przy kolejnych alokacjach o podobnym rozmiarze.
+ */
+
+namespace pamiec {
+
+    /// Wyrównanie każdego bufora w bajtach
+    constexpr std::size_t WYROWNANIE = 64;
+
+    /**
+     * @struct statystyki
+     * @brief Liczniki warstwy alokacji (od uruchomienia lub od zeruj_statystyki)
+     */
+    struct statystyki {
+        std::uint64_t alokacje = 0;      ///< Liczba żądań bufora
+        std::uint64_t z_puli = 0;        ///< Żądania obsłużone buforem z puli
+        std::uint64_t z_systemu = 0;     ///< Żądania obsłużone nową alokacją systemową
+        std::uint64_t zwolnienia = 0;    ///< Liczba zwolnionych buforów
+        std::uint64_t bajty_zadane = 0;  ///< Suma rozmiarów żądanych buforów
+        std::uint64_t bajty_systemu = 0; ///< Suma rozmiarów alokacji systemowych
+        std::uint64_t bledy_stron = 0;   ///< Błędy stron procesu (tylko POSIX, w pozostałych 0)
+    };
+
+    /**
+     * @struct zwalniacz
+     * @brief Deleter std::unique_ptr zwracający bufor do warstwy alokacji
+     */
+    struct zwalniacz {
+        std::size_t bajty = 0;      ///< Rzeczywisty rozmiar bufora (klasa rozmiaru) albo długość mapowania
+        void* mapowanie = nullptr;  ///< Początek mapowania pliku (nullptr dla zwykłych buforów)
+
+        /**
+         * @brief Zwalnia bufor (do puli, do systemu lub przez munmap)
+         * @param p Wskaźnik na bufor
+         */
+        void operator()(int* p) const;
+    };
+
+    /// Bufor danych macierzy zarządzany przez warstwę alokacji
+    using bufor = std::unique_ptr<int[], zwalniacz>;
+
+    /**
+     * @brief Przydziela wyrównany bufor na co najmniej podaną liczbę elementów
+     * @details Zawartość bufora jest nieokreślona.
+     * @param elementy Liczba elementów int
+     * @return Bufor (pusty dla 0 elementów)
+     */
+    bufor przydziel(std::size_t elementy);
+
+    /**
+     * @brief Obejmuje fragment zmapowanego pliku jako bufor macierzy
+     * @details Bufor nie trafia do puli; przy zwolnieniu całe mapowanie jest
+     * usuwane przez munmap. Dostępne tylko na systemach POSIX.
+     * @param mapowanie Początek mapowania (wynik mmap)
+     * @param dlugosc Długość mapowania w bajtach
+     * @param przesuniecie Przesunięcie danych względem początku mapowania (wielokrotność WYROWNANIE)
+     * @return Bufor wskazujący na dane
+     */
+    bufor z_mapowania(void* mapowanie, std::size_t dlugosc, std::size_t przesuniecie);
+
+    /**
+     * @brief Włącza lub wyłącza pulę buforów
+     * @details Po wyłączeniu każdy bufor pochodzi bezpośrednio z systemu
+     * i wraca do niego przy zwolnieniu.
+     * @param wlaczona true aby używać puli
+     */
+    void ustaw_pule(bool wlaczona);
+
+    /**
+     * @brief Ustawia maksymalną liczbę bajtów przechowywanych w puli jednego wątku
+     * @param bajty Limit (domyślnie 64 MiB); 0 wyłącza przechowywanie
+     */
+    void ustaw_limit_puli(std::size_t bajty);
+
+    /**
+     * @brief Zwalnia do systemu wszystkie bufory z puli bieżącego wątku
+     */
+    void oproznij_pule();
+
+    /**
+     * @brief Zwraca bieżące liczniki warstwy alokacji
+     * @return Kopia liczników
+     */
+    statystyki pobierz_statystyki();
+
+    /**
+     * @brief Zeruje liczniki warstwy alokacji
+     */
+    void zeruj_statystyki();
+
+    /**
+     * @brief Wypisuje liczniki do strumienia
+     * @param o Strumień wyjściowy
+     * @param s Liczniki
+     * @return Referencja do strumienia
+     */
+    std::ostream& operator<<(std::ostream& o, const statystyki& s);
+}
+
+#endif
@@ -0,0 +1,203 @@
+/**
+ * @file pamiec_iloczynow.cpp
+ * @brief Implementacja pamięci podręcznej wyników mnożenia i potęgowania
+ */
+
+#include "pamiec_iloczynow.h"
+#include <atomic>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    using pamiec_iloczynow::klucz;
+
+    /**
+     * @struct skrot_klucza
+     * @brief Funkcja mieszająca klucza dla std::unordered_map
+     */
+    struct skrot_klucza {
+        std::size_t operator()(const klucz& k) const noexcept {
+            std::uint64_t h = k.lewy ^ (k.prawy * 0x9E3779B97F4A7C15ull);
+            h ^= (static_cast<std::uint64_t>(k.n) << 32 | static_cast<std::uint32_t>(k.modul)) * 0xBF58476D1CE4E5B9ull;
+            h ^= static_cast<std::uint64_t>(k.rodzaj) << 8 | static_cast<std::uint64_t>(k.tryb);
+            return static_cast<std::size_t>(h ^ (h >> 29));
+        }
+    };
+
+    /**
+     * @struct wpis
+     * @brief Zapamiętany wynik wraz z kluczem, kopiami argumentów i rozmiarem danych
+     */
+    struct wpis {
+        klucz k;                             ///< Klucz działania
+        std::shared_ptr<const matrix> lewy;  ///< Kopia lewego czynnika albo podstawy potęgi
+        std::shared_ptr<const matrix> prawy; ///< Kopia prawego czynnika (nullptr dla potęgi)
+        std::shared_ptr<const matrix> wynik; ///< Wynik (współdzielony z trwającymi odczytami)
+        std::size_t bajty;                   ///< Rozmiar danych wyniku i argumentów
+    };
+
+    /**
+     * @brief Zwraca rozmiar danych macierzy w bajtach
+     */
+    std::size_t rozmiar(const matrix& m) {
+        return static_cast<std::size_t>(m.getSize()) * m.getSize() * sizeof(int);
+    }
+
+    /**
+     * @struct stan_pamieci
+     * @brief Lista LRU wyników z indeksem po kluczu; chroniona blokadą
+     */
+    struct stan_pamieci {
+        std::mutex blokada;
+        std::list<wpis> kolejnosc; ///< Od ostatnio do najdawniej używanego
+        std::unordered_map<klucz, std::list<wpis>::iterator, skrot_klucza> indeks;
+        std::size_t bajty = 0;
+        pamiec_iloczynow::statystyki liczniki;
+
+        /**
+         * @brief Usuwa wpis z listy i indeksu
+         * @param it Usuwany wpis
+         * @param usuniete Odbiera dane wpisu, by zwolnić je poza blokadą
+         */
+        void usun(std::list<wpis>::iterator it, std::vector<std::shared_ptr<const matrix>>& usuniete) {
+            bajty -= it->bajty;
+            indeks.erase(it->k);
+            usuniete.push_back(std::move(it->lewy));
+            usuniete.push_back(std::move(it->prawy));
+            usuniete.push_back(std::move(it->wynik));
+            kolejnosc.erase(it);
+        }
+
+        /**
+         * @brief Usuwa najdawniej używane wyniki, aż ich rozmiar zmieści się w limicie
+         * @param limit Limit w bajtach
+         * @param usuniete Odbiera usunięte wyniki, by zwolnić je poza blokadą
+         * @return Liczba usuniętych wyników
+         */
+        std::uint64_t przytnij(std::size_t limit, std::vector<std::shared_ptr<const matrix>>& usuniete) {
+            std::uint64_t ile = 0;
+            while (bajty > limit && !kolejnosc.empty()) {
+                usun(std::prev(kolejnosc.end()), usuniete);
+                ++ile;
+            }
+            return ile;
+        }
+    };
+
+    std::atomic<std::size_t> limit_bajtow{ 0 }; ///< 0 = pamięć wyłączona
+
+    stan_pamieci& stan() {
+        static stan_pamieci s;
+        return s;
+    }
+}
+
+namespace pamiec_iloczynow {
+
+    void ustaw_limit(std::size_t bajty) {
+        std::vector<std::shared_ptr<const matrix>> usuniete;
+        stan_pamieci& s = stan();
+        std::lock_guard<std::mutex> blokada(s.blokada);
+        limit_bajtow.store(bajty, std::memory_order_relaxed);
+        s.liczniki.usuniecia += s.przytnij(bajty, usuniete);
+    }
+
+    std::size_t limit() {
+        return limit_bajtow.load(std::memory_order_relaxed);
+    }
+
+    bool wlaczona() {
+        return limit() > 0;
+    }
+
+    void wyczysc() {
+        std::vector<std::shared_ptr<const matrix>> usuniete;
+        stan_pamieci& s = stan();
+        std::lock_guard<std::mutex> blokada(s.blokada);
+        s.przytnij(0, usuniete);
+    }
+
+    std::shared_ptr<const matrix> znajdz(const klucz& k, const matrix& lewy, const matrix* prawy) {
+        if (!wlaczona()) return nullptr;
+        stan_pamieci& s = stan();
+        wpis znaleziony;
+        {
+            std::lock_guard<std::mutex> blokada(s.blokada);
+            auto it = s.indeks.find(k);
+            if (it == s.indeks.end()) {
+                ++s.liczniki.chybienia;
+                return nullptr;
+            }
+            s.kolejnosc.splice(s.kolejnosc.begin(), s.kolejnosc, it->second);
+            znaleziony = *it->second;
+        }
+
+        // Porównanie O(n^2) poza blokadą: kopie argumentów są niezmienne
+        bool zgodne = *znaleziony.lewy == lewy
+            && (prawy ? znaleziony.prawy && *znaleziony.prawy == *prawy : !znaleziony.prawy);
+
+        std::vector<std::shared_ptr<const matrix>> usuniete;
+        std::lock_guard<std::mutex> blokada(s.blokada);
+        if (zgodne) {
+            ++s.liczniki.trafienia;
+            return znaleziony.wynik;
+        }
+        ++s.liczniki.chybienia;
+        ++s.liczniki.niezgodne;
+        auto it = s.indeks.find(k);
+        if (it != s.indeks.end() && it->second->wynik == znaleziony.wynik) s.usun(it->second, usuniete);
+        return nullptr;
+    }
+
+    void zapamietaj(const klucz& k, const matrix& lewy, const matrix* prawy, const matrix& wynik) {
+        std::size_t bajty = rozmiar(lewy) + (prawy ? rozmiar(*prawy) : 0) + rozmiar(wynik);
+        if (bajty > limit()) return;
+        wpis nowy{ k, std::make_shared<const matrix>(lewy), prawy ? std::make_shared<const matrix>(*prawy) : nullptr,
+            std::make_shared<const matrix>(wynik), bajty };
+
+        std::vector<std::shared_ptr<const matrix>> usuniete;
+        stan_pamieci& s = stan();
+        std::lock_guard<std::mutex> blokada(s.blokada);
+        std::size_t biezacy = limit_bajtow.load(std::memory_order_relaxed);
+        if (bajty > biezacy) return;
+        auto it = s.indeks.find(k);
+        // Ten sam wynik policzony równolegle przez inny wątek albo wpis o innych argumentach
+        if (it != s.indeks.end()) s.usun(it->second, usuniete);
+        s.kolejnosc.push_front(std::move(nowy));
+        s.indeks.emplace(k, s.kolejnosc.begin());
+        s.bajty += bajty;
+        ++s.liczniki.wstawienia;
+        s.liczniki.usuniecia += s.przytnij(biezacy, usuniete);
+    }
+
+    statystyki pobierz_statystyki() {
+        stan_pamieci& s = stan();
+        std::lock_guard<std::mutex> blokada(s.blokada);
+        statystyki wynik = s.liczniki;
+        wynik.wpisy = s.kolejnosc.size();
+        wynik.bajty = s.bajty;
+        return wynik;
+    }
+
+    void zeruj_statystyki() {
+        stan_pamieci& s = stan();
+        std::lock_guard<std::mutex> blokada(s.blokada);
+        s.liczniki = statystyki{};
+    }
+
+    std::ostream& operator<<(std::ostream& o, const statystyki& s) {
+        o << "trafienia: " << s.trafienia
+            << ", chybienia: " << s.chybienia
+            << ", niezgodne: " << s.niezgodne
+            << ", wstawienia: " << s.wstawienia
+            << ", usuniecia: " << s.usuniecia
+            << ", wpisy: " << s.wpisy
+            << ", bajty: " << s.bajty;
+        return o;
+    }
+}
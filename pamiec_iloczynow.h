@@ -0,0 +1,133 @@
+#ifndef PAMIEC_ILOCZYNOW_H
+#define PAMIEC_ILOCZYNOW_H
+
+#include "matrix.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+
+/**
+ * @file pamiec_iloczynow.h
+ * @brief Pamięć podręczna wyników mnożenia i potęgowania macierzy (LRU z limitem bajtów)
+ *
+ * Domyślnie wyłączona. Po ustawieniu niezerowego limitu operator* oraz
+ * matrix::potega szukają wyniku po kluczu ze skrótów zawartości argumentów
+ * (matrix::skrot), rozmiaru i trybu akumulacji, zanim wykonają O(n^3)
+ * działań. Argumenty, których skrót jest już zapamiętany (np. stałe
+ * macierze przejść), dają klucz w czasie O(1). Gdy wyniki przekroczą
+ * limit, usuwane są najdawniej używane. Funkcje są bezpieczne wątkowo;
+ * trafiony wynik kopiowany jest poza blokadą.
+ *
+ * Wpis przechowuje kopie argumentów, a trafienie klucza zwraca wynik
+ * dopiero po porównaniu ich element po elemencie. Kolizja skrótów albo
+ * nieaktualny skrót (zapis przez wcześniej pobrany wskaźnik) kończy się
+ * chybieniem, nigdy wynikiem innego działania. Kopie argumentów wliczają
+ * się do limitu.
+ */
+
+namespace pamiec_iloczynow {
+
+    /**
+     * @enum dzialanie
+     * @brief Działanie, którego wynik jest zapamiętywany
+     */
+    enum class dzialanie {
+        iloczyn, ///< A * B
+        potega   ///< A^k
+    };
+
+    /**
+     * @struct klucz
+     * @brief Identyfikuje wynik działania na argumentach o danej zawartości
+     */
+    struct klucz {
+        dzialanie rodzaj;     ///< Rodzaj działania
+        tryb_akumulacji tryb; ///< Tryb akumulacji mnożenia
+        int modul;            ///< Moduł trybu modulo (0 w pozostałych trybach)
+        int n;                ///< Rozmiar argumentów
+        std::uint64_t lewy;   ///< Skrót lewego czynnika albo podstawy potęgi
+        std::uint64_t prawy;  ///< Skrót prawego czynnika albo wykładnik potęgi
+
+        bool operator==(const klucz&) const = default;
+    };
+
+    /**
+     * @struct statystyki
+     * @brief Liczniki pamięci iloczynów (od uruchomienia lub od zeruj_statystyki)
+     */
+    struct statystyki {
+        std::uint64_t trafienia = 0;  ///< Wyszukiwania zakończone znalezieniem wyniku
+        std::uint64_t chybienia = 0;  ///< Wyszukiwania bez wyniku (liczonego potem od nowa)
+        std::uint64_t niezgodne = 0;  ///< Chybienia, w których klucz pasował, a argumenty nie
+        std::uint64_t wstawienia = 0; ///< Zapamiętane wyniki
+        std::uint64_t usuniecia = 0;  ///< Wyniki usunięte z powodu limitu
+        std::size_t wpisy = 0;        ///< Bieżąca liczba wyników
+        std::size_t bajty = 0;        ///< Bieżący rozmiar danych wyników i kopii argumentów
+    };
+
+    /**
+     * @brief Ustawia limit rozmiaru danych zapamiętanych wyników
+     * @details Zmniejszenie limitu od razu usuwa najdawniej używane wyniki.
+     * @param bajty Limit w bajtach; 0 (domyślnie) wyłącza pamięć i ją opróżnia
+     */
+    void ustaw_limit(std::size_t bajty);
+
+    /**
+     * @brief Zwraca bieżący limit w bajtach (0 = pamięć wyłączona)
+     */
+    std::size_t limit();
+
+    /**
+     * @brief Sprawdza, czy pamięć iloczynów jest włączona
+     */
+    bool wlaczona();
+
+    /**
+     * @brief Usuwa wszystkie zapamiętane wyniki (limit pozostaje bez zmian)
+     */
+    void wyczysc();
+
+    /**
+     * @brief Szuka wyniku i oznacza go jako ostatnio używany
+     * @details Wpis o pasującym kluczu, lecz innych argumentach, jest usuwany
+     * i liczony jako chybienie.
+     * @param k Klucz działania
+     * @param lewy Lewy czynnik albo podstawa potęgi
+     * @param prawy Prawy czynnik albo nullptr dla potęgi
+     * @return Wynik albo nullptr, gdy go nie ma lub pamięć jest wyłączona
+     */
+    std::shared_ptr<const matrix> znajdz(const klucz& k, const matrix& lewy, const matrix* prawy);
+
+    /**
+     * @brief Zapamiętuje kopię wyniku działania wraz z kopiami argumentów
+     * @details Wpis większy od limitu nie jest zapamiętywany; wpis o tym
+     * samym kluczu zostaje zastąpiony.
+     * @param k Klucz działania
+     * @param lewy Lewy czynnik albo podstawa potęgi
+     * @param prawy Prawy czynnik albo nullptr dla potęgi
+     * @param wynik Wynik
+     */
+    void zapamietaj(const klucz& k, const matrix& lewy, const matrix* prawy, const matrix& wynik);
+
+    /**
+     * @brief Zwraca bieżące liczniki
+     * @return Kopia liczników
+     */
+    statystyki pobierz_statystyki();
+
+    /**
+     * @brief Zeruje liczniki trafień, chybień, wstawień i usunięć
+     */
+    void zeruj_statystyki();
+
+    /**
+     * @brief Wypisuje liczniki do strumienia
+     * @param o Strumień wyjściowy
+     * @param s Liczniki
+     * @return Referencja do strumienia
+     */
+    std::ostream& operator<<(std::ostream& o, const statystyki& s);
+}
+
+#endif
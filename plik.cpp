@@ -0,0 +1,179 @@
+/**
+ * @file plik.cpp
+ * @brief Implementacja binarnego formatu plików macierzy
+ */
+
+#include "plik.h"
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MATRIX_MMAP
+#endif
+
+namespace {
+
+    /// Zamyka plik przy wyjściu z zakresu
+    struct zamykacz {
+        void operator()(std::FILE* f) const { std::fclose(f); }
+    };
+    using uchwyt = std::unique_ptr<std::FILE, zamykacz>;
+
+    uchwyt otworz(const std::string& sciezka, const char* tryb) {
+        uchwyt f(std::fopen(sciezka.c_str(), tryb));
+        if (!f) throw std::logic_error("Nie mozna otworzyc pliku: " + sciezka);
+        return f;
+    }
+
+    std::uint32_t zamien(std::uint32_t x) {
+        return (x >> 24) | ((x >> 8) & 0xFF00u) | ((x << 8) & 0xFF0000u) | (x << 24);
+    }
+
+    std::uint64_t zamien(std::uint64_t x) {
+        return (static_cast<std::uint64_t>(zamien(static_cast<std::uint32_t>(x))) << 32) | zamien(static_cast<std::uint32_t>(x >> 32));
+    }
+
+    /**
+     * @brief Wypełnia nagłówek pliku dla macierzy n×n
+     */
+    plik::naglowek utworz_naglowek(int n) {
+        plik::naglowek h{};
+        std::memcpy(h.magia, plik::MAGIA, sizeof(plik::MAGIA));
+        h.wersja = plik::WERSJA;
+        h.typ = static_cast<std::uint32_t>(plik::typ_elementu::int32);
+        h.kolejnosc = plik::ZNACZNIK_KOLEJNOSCI;
+        h.rozmiar_elementu = sizeof(int);
+        h.n = static_cast<std::uint64_t>(n);
+        h.bajty_danych = static_cast<std::uint64_t>(n) * n * sizeof(int);
+        return h;
+    }
+
+    /**
+     * @brief Czyta dane macierzy z pliku do zwykłego bufora
+     */
+    pamiec::bufor czytaj_dane(const std::string& sciezka, std::size_t elementy, bool zamien_bajty) {
+        uchwyt f = otworz(sciezka, "rb");
+        pamiec::bufor dane = pamiec::przydziel(elementy);
+        if (std::fseek(f.get(), static_cast<long>(plik::ROZMIAR_NAGLOWKA), SEEK_SET) != 0
+            || std::fread(dane.get(), sizeof(int), elementy, f.get()) != elementy)
+            throw std::logic_error("Plik macierzy jest za krotki: " + sciezka);
+        if (zamien_bajty) {
+            for (std::size_t i = 0; i < elementy; ++i)
+                dane[i] = static_cast<int>(zamien(static_cast<std::uint32_t>(dane[i])));
+        }
+        return dane;
+    }
+}
+
+namespace plik {
+
+    tymczasowy::~tymczasowy() {
+        if (!zatwierdzony) std::remove(sciezka_.c_str());
+    }
+
+    void tymczasowy::zatwierdz() {
+#ifdef _WIN32
+        // rename nie nadpisuje istniejącego pliku w systemie Windows
+        std::remove(cel.c_str());
+#endif
+        if (std::rename(sciezka_.c_str(), cel.c_str()) != 0)
+            throw std::logic_error("Nie mozna zapisac pliku: " + cel);
+        zatwierdzony = true;
+    }
+
+    void zapisz(const std::string& sciezka, const int* dane, int n) {
+        naglowek h = utworz_naglowek(n);
+        tymczasowy plik_tymczasowy(sciezka);
+        uchwyt f = otworz(plik_tymczasowy.sciezka(), "wb");
+        std::size_t elementy = static_cast<std::size_t>(n) * n;
+        if (std::fwrite(&h, sizeof(h), 1, f.get()) != 1
+            || (elementy != 0 && std::fwrite(dane, sizeof(int), elementy, f.get()) != elementy)
+            || std::fclose(f.release()) != 0)
+            throw std::logic_error("Nie mozna zapisac pliku: " + sciezka);
+        plik_tymczasowy.zatwierdz();
+    }
+
+    void utworz(const std::string& sciezka, int n) {
+        naglowek h = utworz_naglowek(n);
+        uchwyt f = otworz(sciezka, "wb");
+        bool ok = std::fwrite(&h, sizeof(h), 1, f.get()) == 1;
+        if (ok && h.bajty_danych > 0) {
+            ok = przesun(f.get(), ROZMIAR_NAGLOWKA + h.bajty_danych - 1)
+                && std::fputc(0, f.get()) != EOF;
+        }
+        if (!ok || std::fflush(f.get()) != 0)
+            throw std::logic_error("Nie mozna zapisac pliku: " + sciezka);
+    }
+
+    naglowek czytaj_naglowek(const std::string& sciezka, bool& zamien_bajty) {
+        uchwyt f = otworz(sciezka, "rb");
+        naglowek h{};
+        if (std::fread(&h, sizeof(h), 1, f.get()) != 1 || std::memcmp(h.magia, MAGIA, sizeof(MAGIA)) != 0)
+            throw std::logic_error("Plik nie jest binarnym plikiem macierzy: " + sciezka);
+
+        zamien_bajty = h.kolejnosc != ZNACZNIK_KOLEJNOSCI;
+        if (zamien_bajty) {
+            if (zamien(h.kolejnosc) != ZNACZNIK_KOLEJNOSCI)
+                throw std::logic_error("Niepoprawny znacznik kolejnosci bajtow: " + sciezka);
+            h.wersja = zamien(h.wersja);
+            h.typ = zamien(h.typ);
+            h.kolejnosc = ZNACZNIK_KOLEJNOSCI;
+            h.rozmiar_elementu = zamien(h.rozmiar_elementu);
+            h.n = zamien(h.n);
+            h.bajty_danych = zamien(h.bajty_danych);
+        }
+        if (h.wersja != WERSJA)
+            throw std::logic_error("Nieobslugiwana wersja formatu: " + std::to_string(h.wersja));
+        if (h.typ != static_cast<std::uint32_t>(typ_elementu::int32) || h.rozmiar_elementu != sizeof(int))
+            throw std::logic_error("Nieobslugiwany typ elementow: " + sciezka);
+        if (h.n > static_cast<std::uint64_t>(INT_MAX) || h.bajty_danych != h.n * h.n * sizeof(int))
+            throw std::logic_error("Niepoprawny rozmiar macierzy: " + sciezka);
+        return h;
+    }
+
+    pamiec::bufor wczytaj(const std::string& sciezka, int& n) {
+        bool zamien_bajty = false;
+        naglowek h = czytaj_naglowek(sciezka, zamien_bajty);
+        n = static_cast<int>(h.n);
+        std::size_t elementy = static_cast<std::size_t>(h.n * h.n);
+        if (elementy == 0) return pamiec::przydziel(0);
+
+#ifdef MATRIX_MMAP
+        if (!zamien_bajty) {
+            int fd = open(sciezka.c_str(), O_RDONLY);
+            if (fd < 0) throw std::logic_error("Nie mozna otworzyc pliku: " + sciezka);
+            struct stat st {};
+            std::size_t dlugosc = ROZMIAR_NAGLOWKA + h.bajty_danych;
+            if (fstat(fd, &st) != 0 || static_cast<std::uint64_t>(st.st_size) < dlugosc) {
+                close(fd);
+                throw std::logic_error("Plik macierzy jest za krotki: " + sciezka);
+            }
+            void* mapa = mmap(nullptr, dlugosc, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (mapa != MAP_FAILED) return pamiec::z_mapowania(mapa, dlugosc, ROZMIAR_NAGLOWKA);
+        }
+#endif
+        return czytaj_dane(sciezka, elementy, zamien_bajty);
+    }
+
+    bool przesun(std::FILE* f, std::uint64_t pozycja) {
+#if defined(_WIN32)
+        if (pozycja > static_cast<std::uint64_t>(std::numeric_limits<__int64>::max())) return false;
+        return _fseeki64(f, static_cast<__int64>(pozycja), SEEK_SET) == 0;
+#elif defined(__unix__) || defined(__APPLE__)
+        if (pozycja > static_cast<std::uint64_t>(std::numeric_limits<off_t>::max())) return false;
+        return fseeko(f, static_cast<off_t>(pozycja), SEEK_SET) == 0;
+#else
+        if (pozycja > static_cast<std::uint64_t>(std::numeric_limits<long>::max())) return false;
+        return std::fseek(f, static_cast<long>(pozycja), SEEK_SET) == 0;
+#endif
+    }
+}
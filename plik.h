@@ -0,0 +1,158 @@
+#ifndef PLIK_H
+#define PLIK_H
+
+#include "pamiec.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+/**
+ * @file plik.h
+ * @brief Binarny format plików macierzy i wczytywanie przez mapowanie pamięci
+ *
+ * Plik składa się z 64-bajtowego nagłówka i danych macierzy zapisanych
+ * wierszami jako 32-bitowe liczby całkowite w kolejności bajtów maszyny
+ * zapisującej. Dane zaczynają się na granicy 64 bajtów, więc zmapowany plik
+ * spełnia wymagania wyrównania buforów macierzy (zob. pamiec.h).
+ *
+ * Nie jest częścią publicznego API — korzystają z niego matrix::zapisz()
+ * i matrix::wczytaj().
+ */
+
+namespace plik {
+
+    /// Identyfikator formatu na początku pliku
+    constexpr char MAGIA[8] = { 'M', 'A', 'T', 'R', 'I', 'X', 'B', 'N' };
+
+    /// Bieżąca wersja formatu
+    constexpr std::uint32_t WERSJA = 1;
+
+    /// Znacznik kolejności bajtów zapisywany w kolejności maszyny zapisującej
+    constexpr std::uint32_t ZNACZNIK_KOLEJNOSCI = 0x01020304;
+
+    /// Rozmiar nagłówka (przesunięcie danych w pliku)
+    constexpr std::size_t ROZMIAR_NAGLOWKA = 64;
+
+    /**
+     * @enum typ_elementu
+     * @brief Typ elementów zapisanych w pliku
+     */
+    enum class typ_elementu : std::uint32_t {
+        int32 = 1 ///< 32-bitowa liczba całkowita ze znakiem
+    };
+
+    /**
+     * @struct naglowek
+     * @brief Nagłówek pliku (dokładnie ROZMIAR_NAGLOWKA bajtów)
+     */
+    struct naglowek {
+        char magia[8];              ///< MAGIA
+        std::uint32_t wersja;       ///< Wersja formatu
+        std::uint32_t typ;          ///< typ_elementu
+        std::uint32_t kolejnosc;    ///< ZNACZNIK_KOLEJNOSCI w kolejności bajtów pliku
+        std::uint32_t rozmiar_elementu; ///< Rozmiar elementu w bajtach
+        std::uint64_t n;            ///< Rozmiar macierzy (n×n)
+        std::uint64_t bajty_danych; ///< Długość danych za nagłówkiem
+        char zarezerwowane[24];     ///< Zera (miejsce na przyszłe pola)
+    };
+    static_assert(sizeof(naglowek) == ROZMIAR_NAGLOWKA, "Nagłówek musi mieć 64 bajty");
+
+    /**
+     * @class tymczasowy
+     * @brief Plik sciezka + ".tmp", który zastępuje plik docelowy dopiero po zapisaniu
+     * @details Plik docelowy nie jest nigdy obcinany w miejscu, więc pozostaje
+     * poprawny, gdy jest wciąż zmapowany jako bufor macierzy (zob. wczytaj)
+     * albo czytany jako argument. Niezatwierdzony plik tymczasowy jest usuwany
+     * w destruktorze, a plik docelowy zostaje bez zmian.
+     */
+    class tymczasowy {
+    public:
+        /**
+         * @brief Przygotowuje ścieżkę pliku tymczasowego obok pliku docelowego
+         * @param cel Ścieżka pliku docelowego
+         */
+        explicit tymczasowy(const std::string& cel) : cel(cel), sciezka_(cel + ".tmp") {}
+
+        /**
+         * @brief Usuwa plik tymczasowy, jeśli nie został zatwierdzony
+         */
+        ~tymczasowy();
+
+        tymczasowy(const tymczasowy&) = delete;
+        tymczasowy& operator=(const tymczasowy&) = delete;
+
+        /**
+         * @brief Zwraca ścieżkę pliku tymczasowego
+         */
+        const std::string& sciezka() const { return sciezka_; }
+
+        /**
+         * @brief Przemianowuje zapisany i zamknięty plik tymczasowy na docelowy
+         * @throw std::logic_error Jeśli przemianowanie się nie powiedzie
+         */
+        void zatwierdz();
+
+    private:
+        std::string cel;           ///< Ścieżka pliku docelowego
+        std::string sciezka_;      ///< Ścieżka pliku tymczasowego
+        bool zatwierdzony = false; ///< Czy plik tymczasowy zastąpił docelowy
+    };
+
+    /**
+     * @brief Zapisuje macierz do pliku binarnego
+     * @details Dane trafiają najpierw do pliku tymczasowego (zob. tymczasowy),
+     * więc można zapisać macierz wczytaną z tego samego pliku.
+     * @param sciezka Ścieżka pliku (nadpisywanego)
+     * @param dane Dane macierzy (n*n elementów, wierszami)
+     * @param n Rozmiar macierzy
+     * @throw std::logic_error Jeśli zapis się nie powiedzie
+     */
+    void zapisz(const std::string& sciezka, const int* dane, int n);
+
+    /**
+     * @brief Tworzy plik macierzy n×n z nagłówkiem i wyzerowanymi danymi
+     * @details Dane nie są zapisywane jawnie - plik jest tylko wydłużany do
+     * pełnej długości (na większości systemów plików powstaje plik rzadki).
+     * @param sciezka Ścieżka pliku (nadpisywanego)
+     * @param n Rozmiar macierzy
+     * @throw std::logic_error Jeśli zapis się nie powiedzie
+     */
+    void utworz(const std::string& sciezka, int n);
+
+    /**
+     * @brief Odczytuje i sprawdza nagłówek pliku
+     * @param sciezka Ścieżka pliku
+     * @param zamien_bajty Ustawiane na true, jeśli plik ma przeciwną kolejność bajtów
+     * @return Nagłówek (pola liczbowe w kolejności bajtów maszyny)
+     * @throw std::logic_error Jeśli pliku nie da się otworzyć lub nagłówek jest niepoprawny
+     */
+    naglowek czytaj_naglowek(const std::string& sciezka, bool& zamien_bajty);
+
+    /**
+     * @brief Wczytuje dane macierzy z pliku
+     * @details Na systemach POSIX plik jest mapowany (MAP_PRIVATE) i bufor
+     * wskazuje bezpośrednio na zmapowane strony: wczytanie nie kopiuje danych,
+     * a strony są ładowane leniwie przy pierwszym dostępie. Zapis do bufora
+     * tworzy prywatną kopię strony i nie zmienia pliku. Gdy mapowanie jest
+     * niedostępne albo plik ma przeciwną kolejność bajtów, dane są czytane
+     * do zwykłego bufora.
+     * @param sciezka Ścieżka pliku
+     * @param n Rozmiar wczytanej macierzy (wyjście)
+     * @return Bufor z danymi macierzy
+     * @throw std::logic_error Jeśli plik jest niepoprawny lub za krótki
+     */
+    pamiec::bufor wczytaj(const std::string& sciezka, int& n);
+
+    /**
+     * @brief Ustawia pozycję pliku na przesunięcie od jego początku
+     * @details Używa fseeko (POSIX) albo _fseeki64 (Windows), więc działa
+     * także dla plików większych niż 2 GiB przy 32-bitowym long.
+     * @param f Plik
+     * @param pozycja Przesunięcie w bajtach
+     * @return true, jeśli się udało; false także dla przesunięcia spoza zakresu systemu
+     */
+    bool przesun(std::FILE* f, std::uint64_t pozycja);
+}
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * @file pomiary.cpp
+ * @brief Implementacja liczników operacji klasy matrix
+ */
+
+#include "pomiary.h"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+
+namespace {
+
+#ifdef MATRIX_POMIARY
+    /**
+     * @struct liczniki_atomowe
+     * @brief Liczniki jednej operacji w osobnej linii pamięci podręcznej
+     */
+    struct alignas(64) liczniki_atomowe {
+        std::atomic<std::uint64_t> wywolania{ 0 };
+        std::atomic<std::uint64_t> nanosekundy{ 0 };
+        std::atomic<std::uint64_t> elementy{ 0 };
+        std::atomic<std::uint64_t> alokacje{ 0 };
+        std::atomic<std::uint64_t> bajty{ 0 };
+    };
+
+    liczniki_atomowe wszystkie[pomiary::LICZBA_OPERACJI];
+
+    thread_local std::uint64_t alokacje_watku = 0; ///< Alokacje bieżącego wątku od jego startu
+    thread_local std::uint64_t bajty_watku = 0;    ///< Bajty tych alokacji
+
+    std::int64_t teraz() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+#endif
+
+    const char* const NAZWY[pomiary::LICZBA_OPERACJI] = {
+        "konstrukcja", "kopiowanie", "alokuj", "mnozenie", "dodawanie", "skalar", "tymczasowa",
+        "inkrementacja", "porownanie", "transpozycja", "losowanie", "wypelnianie", "wejscie_wyjscie"
+    };
+}
+
+namespace pomiary {
+
+    const char* nazwa(operacja op) {
+        int i = static_cast<int>(op);
+        return i >= 0 && i < LICZBA_OPERACJI ? NAZWY[i] : "?";
+    }
+
+    migawka pobierz() {
+        migawka m;
+#ifdef MATRIX_POMIARY
+        for (int i = 0; i < LICZBA_OPERACJI; ++i) {
+            m.operacje[i].wywolania = wszystkie[i].wywolania.load(std::memory_order_relaxed);
+            m.operacje[i].nanosekundy = wszystkie[i].nanosekundy.load(std::memory_order_relaxed);
+            m.operacje[i].elementy = wszystkie[i].elementy.load(std::memory_order_relaxed);
+            m.operacje[i].alokacje = wszystkie[i].alokacje.load(std::memory_order_relaxed);
+            m.operacje[i].bajty = wszystkie[i].bajty.load(std::memory_order_relaxed);
+        }
+#endif
+        return m;
+    }
+
+    void zeruj() {
+#ifdef MATRIX_POMIARY
+        for (liczniki_atomowe& l : wszystkie) {
+            l.wywolania.store(0, std::memory_order_relaxed);
+            l.nanosekundy.store(0, std::memory_order_relaxed);
+            l.elementy.store(0, std::memory_order_relaxed);
+            l.alokacje.store(0, std::memory_order_relaxed);
+            l.bajty.store(0, std::memory_order_relaxed);
+        }
+#endif
+    }
+
+    std::ostream& operator<<(std::ostream& o, const migawka& m) {
+        o << std::left << std::setw(18) << "operacja" << std::right << std::setw(12) << "wywolania"
+            << std::setw(14) << "czas [us]" << std::setw(16) << "elementy" << std::setw(12) << "alokacje"
+            << std::setw(16) << "bajty" << "\n";
+        for (int i = 0; i < LICZBA_OPERACJI; ++i) {
+            const liczniki& l = m.operacje[i];
+            if (l.wywolania == 0) continue;
+            o << std::left << std::setw(18) << NAZWY[i] << std::right << std::setw(12) << l.wywolania
+                << std::setw(14) << l.nanosekundy / 1000 << std::setw(16) << l.elementy
+                << std::setw(12) << l.alokacje << std::setw(16) << l.bajty << "\n";
+        }
+        return o;
+    }
+
+    void zarejestruj_alokacje(std::size_t bajty) {
+#ifdef MATRIX_POMIARY
+        ++alokacje_watku;
+        bajty_watku += bajty;
+#else
+        (void)bajty;
+#endif
+    }
+
+#ifdef MATRIX_POMIARY
+    pomiar::pomiar(operacja op, std::size_t elementy)
+        : op(op), elementy(elementy), start(teraz()), alokacje_start(alokacje_watku), bajty_start(bajty_watku) {}
+
+    pomiar::~pomiar() {
+        liczniki_atomowe& l = wszystkie[static_cast<int>(op)];
+        l.wywolania.fetch_add(1, std::memory_order_relaxed);
+        l.nanosekundy.fetch_add(static_cast<std::uint64_t>(teraz() - start), std::memory_order_relaxed);
+        l.elementy.fetch_add(elementy, std::memory_order_relaxed);
+        l.alokacje.fetch_add(alokacje_watku - alokacje_start, std::memory_order_relaxed);
+        l.bajty.fetch_add(bajty_watku - bajty_start, std::memory_order_relaxed);
+    }
+#endif
+}
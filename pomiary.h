@@ -0,0 +1,157 @@
+#ifndef POMIARY_H
+#define POMIARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+/**
+ * @file pomiary.h
+ * @brief Opcjonalne liczniki operacji klasy matrix: wywołania, czas, elementy i alokacje
+ *
+ * Pomiary są kompilowane tylko przy zdefiniowanym MATRIX_POMIARY (opcja
+ * CMake MATRIX_POMIARY=ON). Bez niego makro MATRIX_POMIAR nie generuje
+ * żadnego kodu, a pobierz() zwraca same zera.
+ *
+ * Każda operacja zlicza wywołania, łączny czas, liczbę przetworzonych
+ * elementów oraz liczbę i rozmiar buforów przydzielonych w trakcie
+ * wywołania. Wartości są włączne: mnożenie, które tworzy macierz wynikową,
+ * liczy także jej alokację. Liczniki są atomowe i mogą być aktualizowane
+ * z wielu wątków jednocześnie.
+ */
+
+namespace pomiary {
+
+    /**
+     * @enum operacja
+     * @brief Rodzaj mierzonej operacji
+     */
+    enum class operacja {
+        konstrukcja,    ///< Konstruktory matrix(n) i matrix(n, t)
+        kopiowanie,     ///< Konstruktor kopiujący i przypisanie kopiujące
+        alokuj,         ///< matrix::alokuj (także bez realokacji)
+        mnozenie,       ///< Mnożenie macierzowe (operator*, matrix::mnoz)
+        dodawanie,      ///< Suma dwóch macierzy
+        skalar,         ///< Działania ze skalarem tworzące nową macierz lub w miejscu
+        tymczasowa,     ///< Operatory dla obiektów tymczasowych (liczone w miejscu)
+        inkrementacja,  ///< Postinkrementacja i postdekrementacja
+        porownanie,     ///< Operatory ==, >, < i skrót zawartości
+        transpozycja,   ///< odwroc, odwrocona
+        losowanie,      ///< losuj
+        wypelnianie,    ///< Wzory i przekątne (szachownica, przekatna, diagonalna, ...)
+        wejscie_wyjscie, ///< operator<<, operator>>, zapisz, wczytaj, mnoz_pliki
+        LICZBA          ///< Liczba rodzajów operacji (nie jest operacją)
+    };
+
+    /// Liczba rodzajów operacji
+    constexpr int LICZBA_OPERACJI = static_cast<int>(operacja::LICZBA);
+
+    /**
+     * @struct liczniki
+     * @brief Liczniki jednej operacji
+     */
+    struct liczniki {
+        std::uint64_t wywolania = 0;   ///< Liczba wywołań
+        std::uint64_t nanosekundy = 0; ///< Łączny czas wywołań
+        std::uint64_t elementy = 0;    ///< Łączna liczba przetworzonych elementów
+        std::uint64_t alokacje = 0;    ///< Bufory przydzielone w trakcie wywołań
+        std::uint64_t bajty = 0;       ///< Łączny rozmiar tych buforów
+    };
+
+    /**
+     * @struct migawka
+     * @brief Kopia liczników wszystkich operacji
+     */
+    struct migawka {
+        liczniki operacje[LICZBA_OPERACJI]; ///< Liczniki indeksowane operacją
+    };
+
+    /**
+     * @brief Sprawdza, czy biblioteka została zbudowana z pomiarami
+     * @return true przy zdefiniowanym MATRIX_POMIARY
+     */
+    constexpr bool wlaczone() {
+#ifdef MATRIX_POMIARY
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Zwraca nazwę operacji
+     * @param op Operacja
+     * @return Nazwa tekstowa (np. "mnozenie")
+     */
+    const char* nazwa(operacja op);
+
+    /**
+     * @brief Zwraca bieżące liczniki wszystkich operacji
+     * @return Kopia liczników (same zera, gdy pomiary są wyłączone)
+     */
+    migawka pobierz();
+
+    /**
+     * @brief Zeruje liczniki wszystkich operacji
+     */
+    void zeruj();
+
+    /**
+     * @brief Wypisuje niezerowe liczniki jako tabelę
+     * @param o Strumień wyjściowy
+     * @param m Migawka liczników
+     * @return Referencja do strumienia
+     */
+    std::ostream& operator<<(std::ostream& o, const migawka& m);
+
+    /**
+     * @brief Rejestruje alokację bufora w bieżącym wątku (wywoływane przez pamiec::przydziel)
+     * @param bajty Rozmiar bufora
+     */
+    void zarejestruj_alokacje(std::size_t bajty);
+
+#ifdef MATRIX_POMIARY
+    /**
+     * @class pomiar
+     * @brief Mierzy jedno wywołanie operacji od konstrukcji do zniszczenia obiektu
+     */
+    class pomiar {
+    public:
+        /**
+         * @brief Rozpoczyna pomiar
+         * @param op Mierzona operacja
+         * @param elementy Liczba elementów przetwarzanych przez wywołanie
+         */
+        pomiar(operacja op, std::size_t elementy);
+
+        /**
+         * @brief Kończy pomiar i dodaje wyniki do liczników operacji
+         */
+        ~pomiar();
+
+        pomiar(const pomiar&) = delete;
+        pomiar& operator=(const pomiar&) = delete;
+
+    private:
+        operacja op;                 ///< Mierzona operacja
+        std::size_t elementy;        ///< Elementy przetwarzane przez wywołanie
+        std::int64_t start;          ///< Czas rozpoczęcia (ns, zegar monotoniczny)
+        std::uint64_t alokacje_start; ///< Licznik alokacji wątku na początku
+        std::uint64_t bajty_start;   ///< Licznik bajtów wątku na początku
+    };
+#endif
+}
+
+/**
+ * @def MATRIX_POMIAR
+ * @brief Mierzy resztę bieżącego zakresu jako wywołanie operacji op
+ * @param op Nazwa wartości pomiary::operacja
+ * @param elementy Liczba elementów przetwarzanych przez wywołanie
+ */
+#ifdef MATRIX_POMIARY
+#define MATRIX_POMIAR(op, elementy) ::pomiary::pomiar matrix_pomiar_(::pomiary::operacja::op, (elementy))
+#else
+#define MATRIX_POMIAR(op, elementy) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,228 @@
+/**
+ * @file poza_pamiecia.cpp
+ * @brief Implementacja mnożenia macierzy z plików z wątkiem odczytu z wyprzedzeniem
+ */
+
+#include "poza_pamiecia.h"
+#include "mnozenie.h"
+#include "pamiec.h"
+#include "plik.h"
+#include "simd.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+    constexpr int MIN_KAFEL = 16;      ///< Najmniejszy bok kafla
+    constexpr int WYROWNANIE_KAFLA = 16; ///< Bok kafla jest wielokrotnością tej liczby (NR mikrojądra)
+    constexpr int KOMPLETY = 2;        ///< Liczba kompletów kafli A i B (bieżący + wczytywany)
+    constexpr int BUFORY_KAFLI = 2 * KOMPLETY + 2; ///< Kafle A i B w kompletach + akumulator C + iloczyn
+
+    /// Zamyka plik przy wyjściu z zakresu
+    struct zamykacz {
+        void operator()(std::FILE* f) const { std::fclose(f); }
+    };
+    using uchwyt = std::unique_ptr<std::FILE, zamykacz>;
+
+    uchwyt otworz(const std::string& sciezka, const char* tryb) {
+        uchwyt f(std::fopen(sciezka.c_str(), tryb));
+        if (!f) throw std::logic_error("Nie mozna otworzyc pliku: " + sciezka);
+        return f;
+    }
+
+    /**
+     * @brief Przesunięcie elementu (wiersz, kolumna) w pliku macierzy n×n
+     * @details Liczone w 64 bitach: dla n <= INT_MAX największe przesunięcie
+     * (mniej niż 4 * 2^62 + 64) mieści się w std::uint64_t, a przesunięcia
+     * spoza zakresu systemu odrzuca plik::przesun.
+     */
+    std::uint64_t przesuniecie(int n, int wiersz, int kolumna) {
+        return plik::ROZMIAR_NAGLOWKA + (static_cast<std::uint64_t>(wiersz) * static_cast<std::uint64_t>(n) + static_cast<std::uint64_t>(kolumna)) * sizeof(int);
+    }
+
+    /**
+     * @brief Wczytuje kafel wys×szer zaczynający się w (wiersz, kolumna) do bufora t×t
+     * @details Obszar bufora poza kaflem jest zerowany, więc kafle brzegowe
+     * można mnożyć jak pełne kafle t×t.
+     */
+    void czytaj_kafel(std::FILE* f, int n, int wiersz, int kolumna, int wys, int szer, int* cel, int t) {
+        std::fill(cel, cel + static_cast<std::size_t>(t) * t, 0);
+        for (int i = 0; i < wys; ++i) {
+            if (!plik::przesun(f, przesuniecie(n, wiersz + i, kolumna))
+                || std::fread(cel + static_cast<std::size_t>(i) * t, sizeof(int), szer, f) != static_cast<std::size_t>(szer))
+                throw std::logic_error("Blad odczytu kafla macierzy");
+        }
+    }
+
+    /**
+     * @brief Zapisuje lewy górny obszar wys×szer bufora t×t do pliku w (wiersz, kolumna)
+     */
+    void zapisz_kafel(std::FILE* f, int n, int wiersz, int kolumna, int wys, int szer, const int* zrodlo, int t) {
+        for (int i = 0; i < wys; ++i) {
+            if (!plik::przesun(f, przesuniecie(n, wiersz + i, kolumna))
+                || std::fwrite(zrodlo + static_cast<std::size_t>(i) * t, sizeof(int), szer, f) != static_cast<std::size_t>(szer))
+                throw std::logic_error("Blad zapisu kafla macierzy");
+        }
+    }
+
+    /**
+     * @class kolejka_kafli
+     * @brief Ograniczona kolejka kompletów (kafel A, kafel B) między wątkiem odczytu a obliczeniami
+     *
+     * Wątek odczytu wypełnia wolne komplety w kolejności pętli obliczeń;
+     * wątek liczący odbiera je po kolei i zwalnia po użyciu.
+     */
+    class kolejka_kafli {
+    public:
+        kolejka_kafli(int t) {
+            for (int i = 0; i < KOMPLETY; ++i) {
+                a[i] = pamiec::przydziel(static_cast<std::size_t>(t) * t);
+                b[i] = pamiec::przydziel(static_cast<std::size_t>(t) * t);
+            }
+        }
+
+        /// Czeka na wolny komplet; zwraca jego indeks lub -1 po przerwaniu
+        int wolny() {
+            std::unique_lock<std::mutex> blokada(mutex);
+            cv.wait(blokada, [this] { return gotowe < KOMPLETY || przerwane; });
+            return przerwane ? -1 : (pierwszy + gotowe) % KOMPLETY;
+        }
+
+        /// Oznacza komplet wypełniony przez wątek odczytu jako gotowy
+        void wypelniony() {
+            std::lock_guard<std::mutex> blokada(mutex);
+            ++gotowe;
+            cv.notify_all();
+        }
+
+        /// Czeka na następny gotowy komplet; rzuca wyjątek wątku odczytu
+        int nastepny() {
+            std::unique_lock<std::mutex> blokada(mutex);
+            cv.wait(blokada, [this] { return gotowe > 0 || blad; });
+            if (blad) std::rethrow_exception(blad);
+            return pierwszy;
+        }
+
+        /// Zwalnia komplet odebrany przez nastepny()
+        void zuzyty() {
+            std::lock_guard<std::mutex> blokada(mutex);
+            pierwszy = (pierwszy + 1) % KOMPLETY;
+            --gotowe;
+            cv.notify_all();
+        }
+
+        /// Zapamiętuje wyjątek wątku odczytu
+        void zglos_blad(std::exception_ptr e) {
+            std::lock_guard<std::mutex> blokada(mutex);
+            blad = e;
+            cv.notify_all();
+        }
+
+        /// Przerywa wątek odczytu (np. po błędzie obliczeń lub zapisu)
+        void przerwij() {
+            std::lock_guard<std::mutex> blokada(mutex);
+            przerwane = true;
+            cv.notify_all();
+        }
+
+        pamiec::bufor a[KOMPLETY]; ///< Kafle A
+        pamiec::bufor b[KOMPLETY]; ///< Kafle B
+
+    private:
+        std::mutex mutex;
+        std::condition_variable cv;
+        int pierwszy = 0;          ///< Najstarszy gotowy komplet
+        int gotowe = 0;            ///< Liczba gotowych kompletów
+        bool przerwane = false;
+        std::exception_ptr blad;
+    };
+}
+
+namespace poza_pamiecia {
+
+    void mnoz(const std::string& plik_a, const std::string& plik_b, const std::string& plik_c, std::size_t limit_bajtow) {
+        bool zamien_a = false, zamien_b = false;
+        plik::naglowek ha = plik::czytaj_naglowek(plik_a, zamien_a);
+        plik::naglowek hb = plik::czytaj_naglowek(plik_b, zamien_b);
+        if (ha.n != hb.n) throw std::logic_error("Macierze muszą mieć ten sam rozmiar");
+        if (zamien_a || zamien_b) throw std::logic_error("Mnozenie z plikow wymaga natywnej kolejnosci bajtow");
+        int n = static_cast<int>(ha.n);
+
+        // Bok kafla: BUFORY_KAFLI * t^2 * sizeof(int) <= limit_bajtow
+        int t = MIN_KAFEL;
+        while (t < n && static_cast<std::size_t>(BUFORY_KAFLI) * (t + WYROWNANIE_KAFLA) * (t + WYROWNANIE_KAFLA) * sizeof(int) <= limit_bajtow)
+            t += WYROWNANIE_KAFLA;
+        if (static_cast<std::size_t>(BUFORY_KAFLI) * t * t * sizeof(int) > limit_bajtow)
+            throw std::logic_error("Limit pamieci jest za maly na kafel " + std::to_string(MIN_KAFEL) + "x" + std::to_string(MIN_KAFEL));
+
+        // Wynik trafia do pliku tymczasowego przemianowywanego na końcu, więc
+        // plik_c może być jednym z plików wejściowych, a przy błędzie zostaje bez zmian
+        plik::tymczasowy wynik_tymczasowy(plik_c);
+        plik::utworz(wynik_tymczasowy.sciezka(), n);
+        if (n == 0) {
+            wynik_tymczasowy.zatwierdz();
+            return;
+        }
+        uchwyt fc = otworz(wynik_tymczasowy.sciezka(), "r+b");
+        int kafle = (n + t - 1) / t;
+
+        kolejka_kafli kolejka(t);
+        pamiec::bufor akumulator = pamiec::przydziel(static_cast<std::size_t>(t) * t);
+        pamiec::bufor iloczyn = pamiec::przydziel(static_cast<std::size_t>(t) * t);
+
+        // Wątek odczytu przechodzi kafle w tej samej kolejności co pętla obliczeń
+        std::thread odczyt([&] {
+            try {
+                uchwyt fa = otworz(plik_a, "rb");
+                uchwyt fb = otworz(plik_b, "rb");
+                for (int bi = 0; bi < kafle; ++bi)
+                    for (int bj = 0; bj < kafle; ++bj)
+                        for (int bk = 0; bk < kafle; ++bk) {
+                            int k = kolejka.wolny();
+                            if (k < 0) return;
+                            int wys = std::min(t, n - bi * t), szer = std::min(t, n - bj * t), gl = std::min(t, n - bk * t);
+                            czytaj_kafel(fa.get(), n, bi * t, bk * t, wys, gl, kolejka.a[k].get(), t);
+                            czytaj_kafel(fb.get(), n, bk * t, bj * t, gl, szer, kolejka.b[k].get(), t);
+                            kolejka.wypelniony();
+                        }
+            }
+            catch (...) {
+                kolejka.zglos_blad(std::current_exception());
+            }
+        });
+
+        try {
+            std::size_t ile = static_cast<std::size_t>(t) * t;
+            for (int bi = 0; bi < kafle; ++bi) {
+                for (int bj = 0; bj < kafle; ++bj) {
+                    std::fill(akumulator.get(), akumulator.get() + ile, 0);
+                    for (int bk = 0; bk < kafle; ++bk) {
+                        int k = kolejka.nastepny();
+                        mnozenie::blokowe_rownolegle(kolejka.a[k].get(), kolejka.b[k].get(), iloczyn.get(), t);
+                        kolejka.zuzyty();
+                        simd::dodaj(akumulator.get(), iloczyn.get(), akumulator.get(), ile);
+                    }
+                    zapisz_kafel(fc.get(), n, bi * t, bj * t, std::min(t, n - bi * t), std::min(t, n - bj * t), akumulator.get(), t);
+                }
+            }
+            if (std::fflush(fc.get()) != 0) throw std::logic_error("Nie mozna zapisac pliku: " + plik_c);
+        }
+        catch (...) {
+            kolejka.przerwij();
+            odczyt.join();
+            throw;
+        }
+        odczyt.join();
+
+        if (std::fclose(fc.release()) != 0) throw std::logic_error("Nie mozna zapisac pliku: " + plik_c);
+        wynik_tymczasowy.zatwierdz();
+    }
+}
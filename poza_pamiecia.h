@@ -0,0 +1,36 @@
+#ifndef POZA_PAMIECIA_H
+#define POZA_PAMIECIA_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @file poza_pamiecia.h
+ * @brief Kafelkowe mnożenie macierzy przechowywanych w plikach binarnych
+ *
+ * Macierze A, B i C nie są nigdy wczytywane w całości: wynik liczony jest
+ * kafel po kaflu, a kafle A i B czytane są z dysku przez osobny wątek
+ * wejścia-wyjścia z wyprzedzeniem, więc odczyt nakłada się z obliczeniami.
+ * Nie jest częścią publicznego API — korzysta z niego matrix::mnoz_pliki().
+ */
+
+namespace poza_pamiecia {
+
+    /**
+     * @brief Oblicza C = A * B dla macierzy zapisanych w plikach (zob. plik.h)
+     * @details Bok kafla dobierany jest tak, aby bufory kafli (dwa komplety
+     * A i B dla wątku wejścia-wyjścia, akumulator C i iloczyn częściowy)
+     * zmieściły się w limicie pamięci. Wynik zapisywany jest do pliku
+     * plik_c + ".tmp" i przemianowywany po zakończeniu, więc plik_c może być
+     * jednym z plików wejściowych, a przy błędzie pozostaje bez zmian.
+     * @param plik_a Ścieżka pliku macierzy A
+     * @param plik_b Ścieżka pliku macierzy B
+     * @param plik_c Ścieżka pliku wynikowego (nadpisywanego)
+     * @param limit_bajtow Górne ograniczenie pamięci na bufory kafli
+     * @throw std::logic_error Jeśli pliki są niepoprawne, mają różne rozmiary
+     * albo limit nie mieści nawet najmniejszego kafla
+     */
+    void mnoz(const std::string& plik_a, const std::string& plik_b, const std::string& plik_c, std::size_t limit_bajtow);
+}
+
+#endif
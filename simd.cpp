@@ -0,0 +1,747 @@
+/**
+ * @file simd.cpp
+ * @brief Implementacja jąder wektorowych i wyboru zestawu instrukcji
+ */
+
+#include "simd.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <random>
+
+/**
+ * @def MATRIX_SIMD_X86
+ * @brief Zdefiniowane, gdy kompilator pozwala budować warianty SSE2/AVX2/AVX-512
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MATRIX_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+    using simd::poziom_isa;
+
+    /// Rodzaj działania macierz-skalar
+    enum class dzialanie { dodaj, odejmij, odejmij_od, mnoz };
+
+    /// Relacja sprawdzana dla wszystkich par elementów
+    enum class relacja { rowne, mniejsze };
+
+    constexpr std::size_t BLOK_POROWNANIA = 16; ///< Elementy porównywane przed sprawdzeniem wyniku
+    constexpr int PASY_SKROTU = 8;              ///< 64-bitowe pasy skrótu (po dwa elementy z bloku)
+    constexpr std::size_t BLOK_SKROTU = 2 * PASY_SKROTU;
+
+    constexpr std::uint64_t ZLOTY = 0x9E3779B97F4A7C15ull; ///< Krok pozycji bloku (2^64 / złota proporcja)
+    constexpr std::uint64_t MNOZNIK_1 = 0xBF58476D1CE4E5B9ull; ///< Pierwszy mnożnik SplitMix64
+    constexpr std::uint64_t MNOZNIK_2 = 0x94D049BB133111EBull; ///< Drugi mnożnik SplitMix64
+
+    /// Funkcja mieszająca SplitMix64 (bijekcja z pełną lawinowością)
+    inline std::uint64_t wymieszaj(std::uint64_t z) {
+        z = (z ^ (z >> 30)) * MNOZNIK_1;
+        z = (z ^ (z >> 27)) * MNOZNIK_2;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Zwraca klucze pasów skrótu, losowane raz na uruchomienie procesu
+     * @details Przy jawnych kluczach odwracalne mieszanie pozwalałoby dobrać
+     * dane o równym skrócie, więc klucze pochodzą z std::random_device.
+     */
+    const std::uint64_t* klucze_skrotu() {
+        struct klucze {
+            alignas(64) std::uint64_t pasy[PASY_SKROTU];
+        };
+        static const klucze wylosowane = [] {
+            std::random_device los;
+            std::uint64_t ziarno = (static_cast<std::uint64_t>(los()) << 32) ^ los()
+                ^ static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+            klucze k;
+            for (int l = 0; l < PASY_SKROTU; ++l) k.pasy[l] = wymieszaj(ziarno + (l + 1) * ZLOTY);
+            return k;
+        }();
+        return wylosowane.pasy;
+    }
+
+    /**
+     * @brief Wykonuje działanie na jednym elemencie (arytmetyka modulo 2^32)
+     */
+    template <dzialanie D>
+    inline int skalarnie(int x, int a) {
+        unsigned ux = static_cast<unsigned>(x);
+        unsigned ua = static_cast<unsigned>(a);
+        if constexpr (D == dzialanie::dodaj) return static_cast<int>(ux + ua);
+        else if constexpr (D == dzialanie::odejmij) return static_cast<int>(ux - ua);
+        else if constexpr (D == dzialanie::odejmij_od) return static_cast<int>(ua - ux);
+        else return static_cast<int>(ux * ua);
+    }
+
+    // ==================== Wersje skalarne ====================
+
+    template <dzialanie D>
+    void skalar_skalarny(const int* x, int* z, std::size_t ile, int a) {
+        for (std::size_t i = 0; i < ile; ++i) z[i] = skalarnie<D>(x[i], a);
+    }
+
+    void kopiuj_i_dodaj_skalarny(int* x, int* kopia, std::size_t ile, int a) {
+        for (std::size_t i = 0; i < ile; ++i) {
+            kopia[i] = x[i];
+            x[i] = skalarnie<dzialanie::dodaj>(x[i], a);
+        }
+    }
+
+    void dodaj_skalarny(const int* x, const int* y, int* z, std::size_t ile) {
+        for (std::size_t i = 0; i < ile; ++i) z[i] = skalarnie<dzialanie::dodaj>(x[i], y[i]);
+    }
+
+    void transponuj_8x8_skalarny(const int* a, int lda, int* b, int ldb) {
+        for (int i = 0; i < 8; ++i)
+            for (int j = 0; j < 8; ++j) b[j * ldb + i] = a[i * lda + j];
+    }
+
+    void iloczyny_4x16_skalarny(int kc, const int* a, const int* b, std::int64_t* c, int ldc) {
+        std::int64_t s[4][16] = {};
+        for (int p = 0; p < kc; ++p, a += 4, b += 16)
+            for (int i = 0; i < 4; ++i)
+                for (int j = 0; j < 16; ++j) s[i][j] += static_cast<std::int64_t>(a[i]) * b[j];
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 16; ++j) c[i * ldc + j] += s[i][j];
+    }
+
+    template <relacja R>
+    inline bool spelnia(int x, int y) {
+        if constexpr (R == relacja::rowne) return x == y;
+        else return x < y;
+    }
+
+    template <relacja R>
+    bool wszystkie_skalarny(const int* x, const int* y, std::size_t ile) {
+        for (std::size_t i = 0; i < ile; ++i)
+            if (!spelnia<R>(x[i], y[i])) return false;
+        return true;
+    }
+
+    /**
+     * @brief Dodaje do pasów skrótu jeden blok BLOK_SKROTU elementów
+     * @param pasy Pasy skrótu
+     * @param x Blok danych
+     * @param klucze Klucze pasów
+     * @param pozycja Numer bloku pomnożony przez ZLOTY
+     */
+    void skrot_bloku(std::uint64_t pasy[PASY_SKROTU], const int* x, const std::uint64_t* klucze, std::uint64_t pozycja) {
+        for (int l = 0; l < PASY_SKROTU; ++l) {
+            std::uint64_t d = static_cast<std::uint32_t>(x[2 * l]) | static_cast<std::uint64_t>(static_cast<std::uint32_t>(x[2 * l + 1])) << 32;
+            pasy[l] += wymieszaj(d ^ klucze[l] ^ pozycja);
+        }
+    }
+
+    /**
+     * @brief Dołącza niepełny ostatni blok (uzupełniony zerami) i miesza pasy z liczbą elementów
+     */
+    std::uint64_t zakoncz_skrot(std::uint64_t pasy[PASY_SKROTU], const int* reszta, std::size_t ile_reszty, std::size_t ile) {
+        const std::uint64_t* klucze = klucze_skrotu();
+        if (ile_reszty > 0) {
+            int blok[BLOK_SKROTU] = {};
+            std::copy(reszta, reszta + ile_reszty, blok);
+            skrot_bloku(pasy, blok, klucze, (ile / BLOK_SKROTU) * ZLOTY);
+        }
+        std::uint64_t h = wymieszaj(ile ^ klucze[0]);
+        for (int l = 0; l < PASY_SKROTU; ++l) h = wymieszaj(h ^ pasy[l]);
+        return h;
+    }
+
+    std::uint64_t skrot_skalarny(const int* x, std::size_t ile) {
+        const std::uint64_t* klucze = klucze_skrotu();
+        std::uint64_t pasy[PASY_SKROTU] = {};
+        std::uint64_t pozycja = 0;
+        std::size_t i = 0;
+        for (; i + BLOK_SKROTU <= ile; i += BLOK_SKROTU, pozycja += ZLOTY) skrot_bloku(pasy, x + i, klucze, pozycja);
+        return zakoncz_skrot(pasy, x + i, ile - i, ile);
+    }
+
+#ifdef MATRIX_SIMD_X86
+
+    // ==================== SSE2 ====================
+
+    /**
+     * @brief Mnożenie 32-bitowe (dolne połowy iloczynów) bez SSE4.1
+     */
+    __attribute__((target("sse2")))
+    inline __m128i mullo_sse2(__m128i a, __m128i b) {
+        __m128i parzyste = _mm_mul_epu32(a, b);
+        __m128i nieparzyste = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(parzyste, _MM_SHUFFLE(0, 0, 2, 0)),
+            _mm_shuffle_epi32(nieparzyste, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+
+    template <dzialanie D>
+    __attribute__((target("sse2")))
+    void skalar_sse2(const int* x, int* z, std::size_t ile, int a) {
+        const __m128i w = _mm_set1_epi32(a);
+        std::size_t i = 0;
+        for (; i + 4 <= ile; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+            if constexpr (D == dzialanie::dodaj) v = _mm_add_epi32(v, w);
+            else if constexpr (D == dzialanie::odejmij) v = _mm_sub_epi32(v, w);
+            else if constexpr (D == dzialanie::odejmij_od) v = _mm_sub_epi32(w, v);
+            else v = mullo_sse2(v, w);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(z + i), v);
+        }
+        for (; i < ile; ++i) z[i] = skalarnie<D>(x[i], a);
+    }
+
+    __attribute__((target("sse2")))
+    void kopiuj_i_dodaj_sse2(int* x, int* kopia, std::size_t ile, int a) {
+        const __m128i w = _mm_set1_epi32(a);
+        std::size_t i = 0;
+        for (; i + 4 <= ile; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(kopia + i), v);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(x + i), _mm_add_epi32(v, w));
+        }
+        for (; i < ile; ++i) {
+            kopia[i] = x[i];
+            x[i] = skalarnie<dzialanie::dodaj>(x[i], a);
+        }
+    }
+
+    __attribute__((target("sse2")))
+    void dodaj_sse2(const int* x, const int* y, int* z, std::size_t ile) {
+        std::size_t i = 0;
+        for (; i + 4 <= ile; i += 4) {
+            __m128i u = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(z + i), _mm_add_epi32(u, v));
+        }
+        for (; i < ile; ++i) z[i] = skalarnie<dzialanie::dodaj>(x[i], y[i]);
+    }
+
+    /**
+     * @brief Transpozycja bloku 4×4 w rejestrach SSE2
+     */
+    __attribute__((target("sse2")))
+    inline void transponuj_4x4_sse2(const int* a, int lda, int* b, int ldb) {
+        __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+        __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + lda));
+        __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + 2 * lda));
+        __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + 3 * lda));
+        __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+        __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+        __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+        __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(b), _mm_unpacklo_epi64(t0, t1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(b + ldb), _mm_unpackhi_epi64(t0, t1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(b + 2 * ldb), _mm_unpacklo_epi64(t2, t3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(b + 3 * ldb), _mm_unpackhi_epi64(t2, t3));
+    }
+
+    __attribute__((target("sse2")))
+    void transponuj_8x8_sse2(const int* a, int lda, int* b, int ldb) {
+        transponuj_4x4_sse2(a, lda, b, ldb);
+        transponuj_4x4_sse2(a + 4, lda, b + 4 * ldb, ldb);
+        transponuj_4x4_sse2(a + 4 * lda, lda, b + 4, ldb);
+        transponuj_4x4_sse2(a + 4 * lda + 4, lda, b + 4 * ldb + 4, ldb);
+    }
+
+    /**
+     * @brief Maska czterech par spełniających relację (same jedynki w parze, która ją spełnia)
+     */
+    template <relacja R>
+    __attribute__((target("sse2")))
+    inline __m128i spelnia_sse2(const int* x, const int* y) {
+        __m128i u = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x));
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y));
+        if constexpr (R == relacja::rowne) return _mm_cmpeq_epi32(u, v);
+        else return _mm_cmplt_epi32(u, v);
+    }
+
+    template <relacja R>
+    __attribute__((target("sse2")))
+    bool wszystkie_sse2(const int* x, const int* y, std::size_t ile) {
+        std::size_t i = 0;
+        for (; i + BLOK_POROWNANIA <= ile; i += BLOK_POROWNANIA) {
+            __m128i m = _mm_and_si128(_mm_and_si128(spelnia_sse2<R>(x + i, y + i), spelnia_sse2<R>(x + i + 4, y + i + 4)),
+                _mm_and_si128(spelnia_sse2<R>(x + i + 8, y + i + 8), spelnia_sse2<R>(x + i + 12, y + i + 12)));
+            if (_mm_movemask_epi8(m) != 0xFFFF) return false;
+        }
+        return wszystkie_skalarny<R>(x + i, y + i, ile - i);
+    }
+
+    /**
+     * @brief Dolne 64 bity iloczynu 64×64 złożone z trzech mnożeń 32×32→64
+     */
+    __attribute__((target("sse2")))
+    inline __m128i mullo64_sse2(__m128i a, std::uint64_t c) {
+        __m128i dolna = _mm_set1_epi64x(static_cast<long long>(c & 0xFFFFFFFFull));
+        __m128i gorna = _mm_set1_epi64x(static_cast<long long>(c >> 32));
+        __m128i krzyzowe = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), dolna), _mm_mul_epu32(a, gorna));
+        return _mm_add_epi64(_mm_mul_epu32(a, dolna), _mm_slli_epi64(krzyzowe, 32));
+    }
+
+    /// SplitMix64 na dwóch pasach (zob. wymieszaj)
+    __attribute__((target("sse2")))
+    inline __m128i wymieszaj_sse2(__m128i z) {
+        z = mullo64_sse2(_mm_xor_si128(z, _mm_srli_epi64(z, 30)), MNOZNIK_1);
+        z = mullo64_sse2(_mm_xor_si128(z, _mm_srli_epi64(z, 27)), MNOZNIK_2);
+        return _mm_xor_si128(z, _mm_srli_epi64(z, 31));
+    }
+
+    __attribute__((target("sse2")))
+    std::uint64_t skrot_sse2(const int* x, std::size_t ile) {
+        const std::uint64_t* klucze = klucze_skrotu();
+        __m128i klucz[4], pasy[4];
+        for (int r = 0; r < 4; ++r) {
+            klucz[r] = _mm_load_si128(reinterpret_cast<const __m128i*>(klucze + 2 * r));
+            pasy[r] = _mm_setzero_si128();
+        }
+        __m128i pozycja = _mm_setzero_si128(), krok = _mm_set1_epi64x(static_cast<long long>(ZLOTY));
+        std::size_t i = 0;
+        for (; i + BLOK_SKROTU <= ile; i += BLOK_SKROTU, pozycja = _mm_add_epi64(pozycja, krok)) {
+            for (int r = 0; r < 4; ++r) {
+                __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i + 4 * r));
+                pasy[r] = _mm_add_epi64(pasy[r], wymieszaj_sse2(_mm_xor_si128(_mm_xor_si128(d, klucz[r]), pozycja)));
+            }
+        }
+        alignas(16) std::uint64_t p[PASY_SKROTU];
+        for (int r = 0; r < 4; ++r) _mm_store_si128(reinterpret_cast<__m128i*>(p + 2 * r), pasy[r]);
+        return zakoncz_skrot(p, x + i, ile - i, ile);
+    }
+
+    // ==================== AVX2 ====================
+
+    template <dzialanie D>
+    __attribute__((target("avx2")))
+    void skalar_avx2(const int* x, int* z, std::size_t ile, int a) {
+        const __m256i w = _mm256_set1_epi32(a);
+        std::size_t i = 0;
+        for (; i + 8 <= ile; i += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+            if constexpr (D == dzialanie::dodaj) v = _mm256_add_epi32(v, w);
+            else if constexpr (D == dzialanie::odejmij) v = _mm256_sub_epi32(v, w);
+            else if constexpr (D == dzialanie::odejmij_od) v = _mm256_sub_epi32(w, v);
+            else v = _mm256_mullo_epi32(v, w);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(z + i), v);
+        }
+        for (; i < ile; ++i) z[i] = skalarnie<D>(x[i], a);
+    }
+
+    __attribute__((target("avx2")))
+    void kopiuj_i_dodaj_avx2(int* x, int* kopia, std::size_t ile, int a) {
+        const __m256i w = _mm256_set1_epi32(a);
+        std::size_t i = 0;
+        for (; i + 8 <= ile; i += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(kopia + i), v);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(x + i), _mm256_add_epi32(v, w));
+        }
+        for (; i < ile; ++i) {
+            kopia[i] = x[i];
+            x[i] = skalarnie<dzialanie::dodaj>(x[i], a);
+        }
+    }
+
+    __attribute__((target("avx2")))
+    void dodaj_avx2(const int* x, const int* y, int* z, std::size_t ile) {
+        std::size_t i = 0;
+        for (; i + 8 <= ile; i += 8) {
+            __m256i u = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(z + i), _mm256_add_epi32(u, v));
+        }
+        for (; i < ile; ++i) z[i] = skalarnie<dzialanie::dodaj>(x[i], y[i]);
+    }
+
+    /**
+     * @brief Transpozycja bloku 8×8 w rejestrach AVX2
+     * @details Trzy etapy przeplotu: 32-bitowy, 64-bitowy i 128-bitowy
+     */
+    __attribute__((target("avx2")))
+    void transponuj_8x8_avx2(const int* a, int lda, int* b, int ldb) {
+        __m256i r[8];
+        for (int i = 0; i < 8; ++i)
+            r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i * lda));
+        __m256i t[8];
+        for (int i = 0; i < 4; ++i) {
+            t[2 * i] = _mm256_unpacklo_epi32(r[2 * i], r[2 * i + 1]);
+            t[2 * i + 1] = _mm256_unpackhi_epi32(r[2 * i], r[2 * i + 1]);
+        }
+        __m256i u[8];
+        for (int i = 0; i < 2; ++i) {
+            u[4 * i] = _mm256_unpacklo_epi64(t[4 * i], t[4 * i + 2]);
+            u[4 * i + 1] = _mm256_unpackhi_epi64(t[4 * i], t[4 * i + 2]);
+            u[4 * i + 2] = _mm256_unpacklo_epi64(t[4 * i + 1], t[4 * i + 3]);
+            u[4 * i + 3] = _mm256_unpackhi_epi64(t[4 * i + 1], t[4 * i + 3]);
+        }
+        for (int i = 0; i < 4; ++i) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(b + i * ldb), _mm256_permute2x128_si256(u[i], u[i + 4], 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(b + (i + 4) * ldb), _mm256_permute2x128_si256(u[i], u[i + 4], 0x31));
+        }
+    }
+
+    template <relacja R>
+    __attribute__((target("avx2")))
+    inline __m256i spelnia_avx2(const int* x, const int* y) {
+        __m256i u = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x));
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y));
+        if constexpr (R == relacja::rowne) return _mm256_cmpeq_epi32(u, v);
+        else return _mm256_cmpgt_epi32(v, u);
+    }
+
+    template <relacja R>
+    __attribute__((target("avx2")))
+    bool wszystkie_avx2(const int* x, const int* y, std::size_t ile) {
+        std::size_t i = 0;
+        for (; i + BLOK_POROWNANIA <= ile; i += BLOK_POROWNANIA) {
+            __m256i m = _mm256_and_si256(spelnia_avx2<R>(x + i, y + i), spelnia_avx2<R>(x + i + 8, y + i + 8));
+            if (_mm256_movemask_epi8(m) != -1) return false;
+        }
+        return wszystkie_skalarny<R>(x + i, y + i, ile - i);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i mullo64_avx2(__m256i a, std::uint64_t c) {
+        __m256i dolna = _mm256_set1_epi64x(static_cast<long long>(c & 0xFFFFFFFFull));
+        __m256i gorna = _mm256_set1_epi64x(static_cast<long long>(c >> 32));
+        __m256i krzyzowe = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), dolna), _mm256_mul_epu32(a, gorna));
+        return _mm256_add_epi64(_mm256_mul_epu32(a, dolna), _mm256_slli_epi64(krzyzowe, 32));
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i wymieszaj_avx2(__m256i z) {
+        z = mullo64_avx2(_mm256_xor_si256(z, _mm256_srli_epi64(z, 30)), MNOZNIK_1);
+        z = mullo64_avx2(_mm256_xor_si256(z, _mm256_srli_epi64(z, 27)), MNOZNIK_2);
+        return _mm256_xor_si256(z, _mm256_srli_epi64(z, 31));
+    }
+
+    /**
+     * @brief Jądro iloczynu paneli 4×16 z sumami 64-bitowymi
+     * @details Liczone w dwóch połowach po 8 kolumn, żeby 8 rejestrów sum
+     * i 2 rejestry wiersza B zmieściły się w 16 rejestrach ymm.
+     */
+    __attribute__((target("avx2")))
+    void iloczyny_4x16_avx2(int kc, const int* a, const int* b, std::int64_t* c, int ldc) {
+        for (int j0 = 0; j0 < 16; j0 += 8) {
+            __m256i s[4][2];
+            for (int i = 0; i < 4; ++i) s[i][0] = s[i][1] = _mm256_setzero_si256();
+            const int* ap = a;
+            const int* bp = b + j0;
+            for (int p = 0; p < kc; ++p, ap += 4, bp += 16) {
+                __m256i b0 = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bp)));
+                __m256i b1 = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bp + 4)));
+                for (int i = 0; i < 4; ++i) {
+                    __m256i ai = _mm256_set1_epi64x(ap[i]);
+                    s[i][0] = _mm256_add_epi64(s[i][0], _mm256_mul_epi32(ai, b0));
+                    s[i][1] = _mm256_add_epi64(s[i][1], _mm256_mul_epi32(ai, b1));
+                }
+            }
+            for (int i = 0; i < 4; ++i) {
+                for (int h = 0; h < 2; ++h) {
+                    __m256i* w = reinterpret_cast<__m256i*>(c + i * ldc + j0 + 4 * h);
+                    _mm256_storeu_si256(w, _mm256_add_epi64(_mm256_loadu_si256(w), s[i][h]));
+                }
+            }
+        }
+    }
+
+    __attribute__((target("avx2")))
+    std::uint64_t skrot_avx2(const int* x, std::size_t ile) {
+        const std::uint64_t* klucze = klucze_skrotu();
+        __m256i klucz0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(klucze));
+        __m256i klucz1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(klucze + 4));
+        __m256i pasy0 = _mm256_setzero_si256(), pasy1 = _mm256_setzero_si256();
+        __m256i pozycja = _mm256_setzero_si256(), krok = _mm256_set1_epi64x(static_cast<long long>(ZLOTY));
+        std::size_t i = 0;
+        for (; i + BLOK_SKROTU <= ile; i += BLOK_SKROTU, pozycja = _mm256_add_epi64(pozycja, krok)) {
+            __m256i d0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+            __m256i d1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i + 8));
+            pasy0 = _mm256_add_epi64(pasy0, wymieszaj_avx2(_mm256_xor_si256(_mm256_xor_si256(d0, klucz0), pozycja)));
+            pasy1 = _mm256_add_epi64(pasy1, wymieszaj_avx2(_mm256_xor_si256(_mm256_xor_si256(d1, klucz1), pozycja)));
+        }
+        alignas(32) std::uint64_t p[PASY_SKROTU];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(p), pasy0);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(p + 4), pasy1);
+        return zakoncz_skrot(p, x + i, ile - i, ile);
+    }
+
+    // ==================== AVX-512 ====================
+
+    template <dzialanie D>
+    __attribute__((target("avx512f")))
+    void skalar_avx512(const int* x, int* z, std::size_t ile, int a) {
+        const __m512i w = _mm512_set1_epi32(a);
+        std::size_t i = 0;
+        for (; i + 16 <= ile; i += 16) {
+            __m512i v = _mm512_loadu_si512(x + i);
+            if constexpr (D == dzialanie::dodaj) v = _mm512_add_epi32(v, w);
+            else if constexpr (D == dzialanie::odejmij) v = _mm512_sub_epi32(v, w);
+            else if constexpr (D == dzialanie::odejmij_od) v = _mm512_sub_epi32(w, v);
+            else v = _mm512_mullo_epi32(v, w);
+            _mm512_storeu_si512(z + i, v);
+        }
+        for (; i < ile; ++i) z[i] = skalarnie<D>(x[i], a);
+    }
+
+    __attribute__((target("avx512f")))
+    void kopiuj_i_dodaj_avx512(int* x, int* kopia, std::size_t ile, int a) {
+        const __m512i w = _mm512_set1_epi32(a);
+        std::size_t i = 0;
+        for (; i + 16 <= ile; i += 16) {
+            __m512i v = _mm512_loadu_si512(x + i);
+            _mm512_storeu_si512(kopia + i, v);
+            _mm512_storeu_si512(x + i, _mm512_add_epi32(v, w));
+        }
+        for (; i < ile; ++i) {
+            kopia[i] = x[i];
+            x[i] = skalarnie<dzialanie::dodaj>(x[i], a);
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    void dodaj_avx512(const int* x, const int* y, int* z, std::size_t ile) {
+        std::size_t i = 0;
+        for (; i + 16 <= ile; i += 16) {
+            __m512i u = _mm512_loadu_si512(x + i);
+            __m512i v = _mm512_loadu_si512(y + i);
+            _mm512_storeu_si512(z + i, _mm512_add_epi32(u, v));
+        }
+        for (; i < ile; ++i) z[i] = skalarnie<dzialanie::dodaj>(x[i], y[i]);
+    }
+
+    template <relacja R>
+    __attribute__((target("avx512f")))
+    bool wszystkie_avx512(const int* x, const int* y, std::size_t ile) {
+        std::size_t i = 0;
+        for (; i + BLOK_POROWNANIA <= ile; i += BLOK_POROWNANIA) {
+            __m512i u = _mm512_loadu_si512(x + i);
+            __m512i v = _mm512_loadu_si512(y + i);
+            __mmask16 naruszenia;
+            if constexpr (R == relacja::rowne) naruszenia = _mm512_cmpneq_epi32_mask(u, v);
+            else naruszenia = _mm512_cmpge_epi32_mask(u, v);
+            if (naruszenia) return false;
+        }
+        return wszystkie_skalarny<R>(x + i, y + i, ile - i);
+    }
+
+    // Przesunięcia i mnożenia AVX-512 w wersjach z pełną maską: bez maski
+    // GCC 12 ostrzega o _mm512_undefined_epi32 w nagłówku.
+
+    __attribute__((target("avx512f")))
+    inline __m512i mullo64_avx512(__m512i a, std::uint64_t c) {
+        __m512i dolna = _mm512_set1_epi64(static_cast<long long>(c & 0xFFFFFFFFull));
+        __m512i gorna = _mm512_set1_epi64(static_cast<long long>(c >> 32));
+        __m512i krzyzowe = _mm512_add_epi64(_mm512_maskz_mul_epu32(0xFF, _mm512_maskz_srli_epi64(0xFF, a, 32), dolna),
+            _mm512_maskz_mul_epu32(0xFF, a, gorna));
+        return _mm512_add_epi64(_mm512_maskz_mul_epu32(0xFF, a, dolna), _mm512_maskz_slli_epi64(0xFF, krzyzowe, 32));
+    }
+
+    __attribute__((target("avx512f")))
+    inline __m512i wymieszaj_avx512(__m512i z) {
+        z = mullo64_avx512(_mm512_xor_si512(z, _mm512_maskz_srli_epi64(0xFF, z, 30)), MNOZNIK_1);
+        z = mullo64_avx512(_mm512_xor_si512(z, _mm512_maskz_srli_epi64(0xFF, z, 27)), MNOZNIK_2);
+        return _mm512_xor_si512(z, _mm512_maskz_srli_epi64(0xFF, z, 31));
+    }
+
+    __attribute__((target("avx512f")))
+    void iloczyny_4x16_avx512(int kc, const int* a, const int* b, std::int64_t* c, int ldc) {
+        __m512i s[4][2];
+        for (int i = 0; i < 4; ++i) s[i][0] = s[i][1] = _mm512_setzero_si512();
+        for (int p = 0; p < kc; ++p, a += 4, b += 16) {
+            __m512i b0 = _mm512_maskz_cvtepi32_epi64(0xFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));
+            __m512i b1 = _mm512_maskz_cvtepi32_epi64(0xFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 8)));
+            for (int i = 0; i < 4; ++i) {
+                __m512i ai = _mm512_set1_epi64(a[i]);
+                s[i][0] = _mm512_add_epi64(s[i][0], _mm512_maskz_mul_epi32(0xFF, ai, b0));
+                s[i][1] = _mm512_add_epi64(s[i][1], _mm512_maskz_mul_epi32(0xFF, ai, b1));
+            }
+        }
+        for (int i = 0; i < 4; ++i) {
+            for (int h = 0; h < 2; ++h) {
+                std::int64_t* w = c + i * ldc + 8 * h;
+                _mm512_storeu_si512(w, _mm512_add_epi64(_mm512_loadu_si512(w), s[i][h]));
+            }
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    std::uint64_t skrot_avx512(const int* x, std::size_t ile) {
+        __m512i klucz = _mm512_load_si512(klucze_skrotu());
+        __m512i pasy = _mm512_setzero_si512();
+        __m512i pozycja = _mm512_setzero_si512(), krok = _mm512_set1_epi64(static_cast<long long>(ZLOTY));
+        std::size_t i = 0;
+        for (; i + BLOK_SKROTU <= ile; i += BLOK_SKROTU, pozycja = _mm512_add_epi64(pozycja, krok)) {
+            __m512i d = _mm512_loadu_si512(x + i);
+            pasy = _mm512_add_epi64(pasy, wymieszaj_avx512(_mm512_xor_si512(_mm512_xor_si512(d, klucz), pozycja)));
+        }
+        alignas(64) std::uint64_t p[PASY_SKROTU];
+        _mm512_store_si512(p, pasy);
+        return zakoncz_skrot(p, x + i, ile - i, ile);
+    }
+
+#endif
+
+    // ==================== Wybór poziomu ====================
+
+    /**
+     * @brief Wykrywa najszerszy zestaw instrukcji obsługiwany przez procesor
+     */
+    poziom_isa wykryj() {
+#ifdef MATRIX_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return poziom_isa::avx512;
+        if (__builtin_cpu_supports("avx2")) return poziom_isa::avx2;
+        if (__builtin_cpu_supports("sse2")) return poziom_isa::sse2;
+#endif
+        return poziom_isa::skalarny;
+    }
+
+    /**
+     * @brief Poziom początkowy: wykryty, ewentualnie obniżony przez MATRIX_SIMD
+     */
+    poziom_isa poziom_poczatkowy() {
+        poziom_isa p = simd::wykryty_poziom();
+        if (const char* env = std::getenv("MATRIX_SIMD")) {
+            for (poziom_isa kandydat : { poziom_isa::skalarny, poziom_isa::sse2, poziom_isa::avx2, poziom_isa::avx512 }) {
+                if (std::strcmp(env, simd::nazwa(kandydat)) == 0 && kandydat < p) p = kandydat;
+            }
+        }
+        return p;
+    }
+
+    std::atomic<int> aktywny_poziom{ -1 }; ///< Aktywny poziom ISA (-1 = jeszcze nie ustalony)
+
+    template <dzialanie D>
+    void wykonaj(const int* x, int* z, std::size_t ile, int a) {
+        switch (simd::poziom()) {
+#ifdef MATRIX_SIMD_X86
+        case poziom_isa::avx512: skalar_avx512<D>(x, z, ile, a); return;
+        case poziom_isa::avx2: skalar_avx2<D>(x, z, ile, a); return;
+        case poziom_isa::sse2: skalar_sse2<D>(x, z, ile, a); return;
+#endif
+        default: skalar_skalarny<D>(x, z, ile, a); return;
+        }
+    }
+
+    template <relacja R>
+    bool wszystkie(const int* x, const int* y, std::size_t ile) {
+        switch (simd::poziom()) {
+#ifdef MATRIX_SIMD_X86
+        case poziom_isa::avx512: return wszystkie_avx512<R>(x, y, ile);
+        case poziom_isa::avx2: return wszystkie_avx2<R>(x, y, ile);
+        case poziom_isa::sse2: return wszystkie_sse2<R>(x, y, ile);
+#endif
+        default: return wszystkie_skalarny<R>(x, y, ile);
+        }
+    }
+}
+
+namespace simd {
+
+    poziom_isa wykryty_poziom() {
+        static const poziom_isa wykryty = wykryj();
+        return wykryty;
+    }
+
+    poziom_isa poziom() {
+        int p = aktywny_poziom.load(std::memory_order_relaxed);
+        if (p < 0) {
+            p = static_cast<int>(poziom_poczatkowy());
+            aktywny_poziom.store(p, std::memory_order_relaxed);
+        }
+        return static_cast<poziom_isa>(p);
+    }
+
+    void ustaw_poziom(poziom_isa p) {
+        if (p > wykryty_poziom()) p = wykryty_poziom();
+        aktywny_poziom.store(static_cast<int>(p), std::memory_order_relaxed);
+    }
+
+    const char* nazwa(poziom_isa p) {
+        switch (p) {
+        case poziom_isa::sse2: return "sse2";
+        case poziom_isa::avx2: return "avx2";
+        case poziom_isa::avx512: return "avx512";
+        default: return "skalarny";
+        }
+    }
+
+    void dodaj_skalar(const int* x, int* z, std::size_t ile, int a) {
+        wykonaj<dzialanie::dodaj>(x, z, ile, a);
+    }
+
+    void odejmij_skalar(const int* x, int* z, std::size_t ile, int a) {
+        wykonaj<dzialanie::odejmij>(x, z, ile, a);
+    }
+
+    void odejmij_od_skalara(const int* x, int* z, std::size_t ile, int a) {
+        wykonaj<dzialanie::odejmij_od>(x, z, ile, a);
+    }
+
+    void mnoz_skalar(const int* x, int* z, std::size_t ile, int a) {
+        wykonaj<dzialanie::mnoz>(x, z, ile, a);
+    }
+
+    void kopiuj_i_dodaj(int* x, int* kopia, std::size_t ile, int a) {
+        switch (poziom()) {
+#ifdef MATRIX_SIMD_X86
+        case poziom_isa::avx512: kopiuj_i_dodaj_avx512(x, kopia, ile, a); return;
+        case poziom_isa::avx2: kopiuj_i_dodaj_avx2(x, kopia, ile, a); return;
+        case poziom_isa::sse2: kopiuj_i_dodaj_sse2(x, kopia, ile, a); return;
+#endif
+        default: kopiuj_i_dodaj_skalarny(x, kopia, ile, a); return;
+        }
+    }
+
+    void dodaj(const int* x, const int* y, int* z, std::size_t ile) {
+        switch (poziom()) {
+#ifdef MATRIX_SIMD_X86
+        case poziom_isa::avx512: dodaj_avx512(x, y, z, ile); return;
+        case poziom_isa::avx2: dodaj_avx2(x, y, z, ile); return;
+        case poziom_isa::sse2: dodaj_sse2(x, y, z, ile); return;
+#endif
+        default: dodaj_skalarny(x, y, z, ile); return;
+        }
+    }
+
+    bool rowne(const int* x, const int* y, std::size_t ile) {
+        return wszystkie<relacja::rowne>(x, y, ile);
+    }
+
+    bool mniejsze(const int* x, const int* y, std::size_t ile) {
+        return wszystkie<relacja::mniejsze>(x, y, ile);
+    }
+
+    std::uint64_t skrot(const int* x, std::size_t ile) {
+        switch (poziom()) {
+#ifdef MATRIX_SIMD_X86
+        case poziom_isa::avx512: return skrot_avx512(x, ile);
+        case poziom_isa::avx2: return skrot_avx2(x, ile);
+        case poziom_isa::sse2: return skrot_sse2(x, ile);
+#endif
+        default: return skrot_skalarny(x, ile);
+        }
+    }
+
+    jadro_transpozycji_8x8 transpozycja_8x8() {
+        switch (poziom()) {
+#ifdef MATRIX_SIMD_X86
+        case poziom_isa::avx512:
+        case poziom_isa::avx2: return transponuj_8x8_avx2;
+        case poziom_isa::sse2: return transponuj_8x8_sse2;
+#endif
+        default: return transponuj_8x8_skalarny;
+        }
+    }
+
+    jadro_iloczynow_4x16 iloczyny_4x16_64() {
+        switch (poziom()) {
+#ifdef MATRIX_SIMD_X86
+        case poziom_isa::avx512: return iloczyny_4x16_avx512;
+        case poziom_isa::avx2: return iloczyny_4x16_avx2;
+#endif
+        default: return iloczyny_4x16_skalarny;
+        }
+    }
+}
@@ -0,0 +1,193 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file simd.h
+ * @brief Wektorowe jądra operacji element po elemencie z wyborem ISA w czasie działania
+ *
+ * Każde jądro ma wersję skalarną oraz (na x86 z GCC/Clang) wersje SSE2, AVX2
+ * i AVX-512. Przy pierwszym użyciu wykrywany jest najszerszy zestaw
+ * instrukcji obsługiwany przez procesor; można go obniżyć przez
+ * simd::ustaw_poziom() albo zmienną środowiskową MATRIX_SIMD
+ * (skalarny, sse2, avx2, avx512).
+ *
+ * Arytmetyka jest modulo 2^32 we wszystkich wariantach, więc wyniki są
+ * identyczne niezależnie od wybranego poziomu.
+ */
+
+/**
+ * @def MATRIX_KLONY_SIMD
+ * @brief Kompiluje funkcję w kilku wariantach ISA wybieranych w czasie uruchomienia
+ * @details Na GCC/x86-64/Linux jądro otrzymuje klony AVX-512, AVX2 i bazowy;
+ * loader wybiera najszerszy wariant obsługiwany przez procesor. Służy
+ * pętlom, które kompilator wektoryzuje sam (np. jądra mnożenia).
+ */
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__) && !defined(__SANITIZE_THREAD__)
+#define MATRIX_KLONY_SIMD __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define MATRIX_KLONY_SIMD
+#endif
+
+namespace simd {
+
+    /**
+     * @enum poziom_isa
+     * @brief Zestaw instrukcji używany przez jądra wektorowe
+     */
+    enum class poziom_isa {
+        skalarny, ///< Zwykłe pętle bez jawnych instrukcji wektorowych
+        sse2,     ///< 128-bitowe rejestry (4 liczby int)
+        avx2,     ///< 256-bitowe rejestry (8 liczb int)
+        avx512    ///< 512-bitowe rejestry (16 liczb int)
+    };
+
+    /**
+     * @brief Zwraca najszerszy zestaw instrukcji obsługiwany przez procesor
+     * @return Wykryty poziom ISA
+     */
+    poziom_isa wykryty_poziom();
+
+    /**
+     * @brief Zwraca zestaw instrukcji aktualnie używany przez jądra
+     * @return Aktywny poziom ISA
+     */
+    poziom_isa poziom();
+
+    /**
+     * @brief Ustawia zestaw instrukcji używany przez jądra
+     * @param p Żądany poziom; wartości powyżej wykrytego są obniżane do wykrytego
+     */
+    void ustaw_poziom(poziom_isa p);
+
+    /**
+     * @brief Zwraca nazwę poziomu ISA
+     * @param p Poziom ISA
+     * @return Nazwa tekstowa (np. "avx2")
+     */
+    const char* nazwa(poziom_isa p);
+
+    /**
+     * @brief z[i] = x[i] + a
+     * @param x Bufor wejściowy
+     * @param z Bufor wyjściowy (może być równy x)
+     * @param ile Liczba elementów
+     * @param a Skalar
+     */
+    void dodaj_skalar(const int* x, int* z, std::size_t ile, int a);
+
+    /**
+     * @brief z[i] = x[i] - a
+     * @param x Bufor wejściowy
+     * @param z Bufor wyjściowy (może być równy x)
+     * @param ile Liczba elementów
+     * @param a Skalar
+     */
+    void odejmij_skalar(const int* x, int* z, std::size_t ile, int a);
+
+    /**
+     * @brief z[i] = a - x[i]
+     * @param x Bufor wejściowy
+     * @param z Bufor wyjściowy (może być równy x)
+     * @param ile Liczba elementów
+     * @param a Skalar
+     */
+    void odejmij_od_skalara(const int* x, int* z, std::size_t ile, int a);
+
+    /**
+     * @brief z[i] = x[i] * a
+     * @param x Bufor wejściowy
+     * @param z Bufor wyjściowy (może być równy x)
+     * @param ile Liczba elementów
+     * @param a Skalar
+     */
+    void mnoz_skalar(const int* x, int* z, std::size_t ile, int a);
+
+    /**
+     * @brief kopia[i] = x[i], a następnie x[i] += a (jednym przebiegiem)
+     * @details Jądro operatorów postinkrementacji i postdekrementacji.
+     * @param x Bufor modyfikowany w miejscu
+     * @param kopia Bufor na wartości sprzed modyfikacji
+     * @param ile Liczba elementów
+     * @param a Skalar
+     */
+    void kopiuj_i_dodaj(int* x, int* kopia, std::size_t ile, int a);
+
+    /**
+     * @brief z[i] = x[i] + y[i]
+     * @param x Pierwszy bufor wejściowy
+     * @param y Drugi bufor wejściowy
+     * @param z Bufor wyjściowy (może być równy x lub y)
+     * @param ile Liczba elementów
+     */
+    void dodaj(const int* x, const int* y, int* z, std::size_t ile);
+
+    /**
+     * @brief Sprawdza, czy x[i] == y[i] dla wszystkich i
+     * @details Elementy porównywane są blokami po 16; pierwszy blok
+     * z różnicą kończy przegląd.
+     * @param x Pierwszy bufor
+     * @param y Drugi bufor
+     * @param ile Liczba elementów
+     * @return true, jeśli bufory są równe
+     */
+    bool rowne(const int* x, const int* y, std::size_t ile);
+
+    /**
+     * @brief Sprawdza, czy x[i] < y[i] dla wszystkich i (porównanie ze znakiem)
+     * @details Przegląd kończy się na pierwszym bloku z naruszeniem, jak w rowne().
+     * @param x Pierwszy bufor
+     * @param y Drugi bufor
+     * @param ile Liczba elementów
+     * @return true, jeśli każdy element x jest mniejszy od odpowiadającego elementu y
+     */
+    bool mniejsze(const int* x, const int* y, std::size_t ile);
+
+    /**
+     * @brief Zwraca 64-bitowy skrót zawartości bufora (nie kryptograficzny)
+     * @details Osiem 64-bitowych pasów przyjmuje po dwa elementy z każdego
+     * bloku 16 elementów: pas += mix(d ^ k ^ p), gdzie d to para elementów,
+     * k losowy klucz pasa, p numer bloku pomnożony przez stałą, a mix to
+     * funkcja SplitMix64 (pełna lawinowość każdego słowa). Mnożenia 64-bitowe
+     * składane są z mnożeń 32×32→64 dostępnych od SSE2. Na końcu pasy
+     * i liczba elementów mieszane są tą samą funkcją. Klucze losowane są raz
+     * na proces, więc skrót jest identyczny na każdym poziomie ISA, ale różni
+     * się między uruchomieniami i nie powinien być zapisywany.
+     * @param x Bufor wejściowy
+     * @param ile Liczba elementów
+     * @return Skrót
+     */
+    std::uint64_t skrot(const int* x, std::size_t ile);
+
+    /**
+     * @brief Jądro transpozycji bloku 8×8: b[j*ldb + i] = a[i*lda + j]
+     */
+    using jadro_transpozycji_8x8 = void (*)(const int* a, int lda, int* b, int ldb);
+
+    /**
+     * @brief Zwraca jądro transpozycji bloku 8×8 dla aktywnego poziomu ISA
+     * @details Wynik warto pobrać raz na całą transpozycję macierzy
+     * @return Wskaźnik na funkcję jądra
+     */
+    jadro_transpozycji_8x8 transpozycja_8x8();
+
+    /**
+     * @brief Jądro iloczynu paneli: c[i*ldc + j] += suma po p z a[4p + i] * b[16p + j]
+     * @details Panel a ma kc kolumn po 4 elementy, panel b kc wierszy po 16
+     * (układ pakowania mnożenia blokowego). Iloczyny i sumy są 64-bitowe ze
+     * znakiem; wywołujący gwarantuje, że sumy nie przepełnią int64.
+     */
+    using jadro_iloczynow_4x16 = void (*)(int kc, const int* a, const int* b, std::int64_t* c, int ldc);
+
+    /**
+     * @brief Zwraca jądro iloczynu paneli 4×16 z sumami 64-bitowymi dla aktywnego poziomu ISA
+     * @details Poziom sse2 używa jądra skalarnego: mnożenie 32×32→64 ze znakiem
+     * pojawia się dopiero w SSE4.1.
+     * @return Wskaźnik na funkcję jądra
+     */
+    jadro_iloczynow_4x16 iloczyny_4x16_64();
+}
+
+#endif
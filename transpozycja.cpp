@@ -0,0 +1,129 @@
+/**
+ * @file transpozycja.cpp
+ * @brief Implementacja rekurencyjnej, kafelkowej transpozycji macierzy
+ */
+
+#include "transpozycja.h"
+#include "simd.h"
+#include <algorithm>
+
+namespace {
+
+    constexpr int KAFEL = 8;      ///< Bok kafla transponowanego w rejestrach
+    constexpr int LISC_KAFLI = 4; ///< Bok liścia rekurencji w kaflach (32×32 elementów)
+
+    /**
+     * @struct kontekst
+     * @brief Dane wspólne dla całej rekurencji jednej transpozycji
+     */
+    struct kontekst {
+        simd::jadro_transpozycji_8x8 jadro; ///< Jądro 8×8 wybrane raz na transpozycję
+        int n;                              ///< Rozmiar macierzy (stride wierszy)
+    };
+
+    // ==================== Poza miejscem ====================
+
+    /**
+     * @brief B^T ← A dla kafli [i0, i1) × [j0, j1) (indeksy w kaflach)
+     */
+    void poza_rek(const kontekst& k, const int* a, int* b, int i0, int i1, int j0, int j1) {
+        int wys = i1 - i0, szer = j1 - j0;
+        if (wys <= LISC_KAFLI && szer <= LISC_KAFLI) {
+            for (int i = i0; i < i1; ++i)
+                for (int j = j0; j < j1; ++j)
+                    k.jadro(a + (i * k.n + j) * KAFEL, k.n, b + (j * k.n + i) * KAFEL, k.n);
+            return;
+        }
+        if (wys >= szer) {
+            int s = i0 + wys / 2;
+            poza_rek(k, a, b, i0, s, j0, j1);
+            poza_rek(k, a, b, s, i1, j0, j1);
+        }
+        else {
+            int s = j0 + szer / 2;
+            poza_rek(k, a, b, i0, i1, j0, s);
+            poza_rek(k, a, b, i0, i1, s, j1);
+        }
+    }
+
+    // ==================== W miejscu ====================
+
+    /**
+     * @brief Zamienia kafel (i, j) z transpozycją kafla (j, i)
+     * @details Przy i == j transponuje kafel na przekątnej
+     */
+    void zamien_kafle(const kontekst& k, int* a, int i, int j) {
+        int tymczasowy[KAFEL * KAFEL];
+        int* p = a + (i * k.n + j) * KAFEL;
+        int* q = a + (j * k.n + i) * KAFEL;
+        k.jadro(p, k.n, tymczasowy, KAFEL);
+        if (i != j) k.jadro(q, k.n, p, k.n);
+        for (int r = 0; r < KAFEL; ++r)
+            std::copy(tymczasowy + r * KAFEL, tymczasowy + (r + 1) * KAFEL, q + r * k.n);
+    }
+
+    /**
+     * @brief Zamienia obszar kafli [i0, i1) × [j0, j1) z jego lustrzanym odbiciem
+     * @details Obszar leży w całości nad przekątną
+     */
+    void zamien_rek(const kontekst& k, int* a, int i0, int i1, int j0, int j1) {
+        int wys = i1 - i0, szer = j1 - j0;
+        if (wys <= LISC_KAFLI && szer <= LISC_KAFLI) {
+            for (int i = i0; i < i1; ++i)
+                for (int j = j0; j < j1; ++j) zamien_kafle(k, a, i, j);
+            return;
+        }
+        if (wys >= szer) {
+            int s = i0 + wys / 2;
+            zamien_rek(k, a, i0, s, j0, j1);
+            zamien_rek(k, a, s, i1, j0, j1);
+        }
+        else {
+            int s = j0 + szer / 2;
+            zamien_rek(k, a, i0, i1, j0, s);
+            zamien_rek(k, a, i0, i1, s, j1);
+        }
+    }
+
+    /**
+     * @brief Transponuje w miejscu kwadrat kafli [p, q) × [p, q) leżący na przekątnej
+     */
+    void przekatna_rek(const kontekst& k, int* a, int p, int q) {
+        if (q - p <= LISC_KAFLI) {
+            for (int i = p; i < q; ++i)
+                for (int j = i; j < q; ++j) zamien_kafle(k, a, i, j);
+            return;
+        }
+        int s = p + (q - p) / 2;
+        przekatna_rek(k, a, p, s);
+        przekatna_rek(k, a, s, q);
+        zamien_rek(k, a, p, s, s, q);
+    }
+}
+
+namespace transpozycja {
+
+    void w_miejscu(int* a, int n) {
+        kontekst k{ simd::transpozycja_8x8(), n };
+        int kafle = n / KAFEL;
+        przekatna_rek(k, a, 0, kafle);
+
+        // Brzegowe wiersze i kolumny, które nie tworzą pełnego kafla
+        for (int i = 0; i < n; ++i)
+            for (int j = std::max(i + 1, kafle * KAFEL); j < n; ++j)
+                std::swap(a[i * n + j], a[j * n + i]);
+    }
+
+    void poza_miejscem(const int* a, int* b, int n) {
+        kontekst k{ simd::transpozycja_8x8(), n };
+        int kafle = n / KAFEL;
+        poza_rek(k, a, b, 0, kafle, 0, kafle);
+
+        int brzeg = kafle * KAFEL;
+        for (int i = 0; i < n; ++i) {
+            for (int j = (i < brzeg ? brzeg : 0); j < n; ++j) {
+                b[j * n + i] = a[i * n + j];
+            }
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef TRANSPOZYCJA_H
+#define TRANSPOZYCJA_H
+
+/**
+ * @file transpozycja.h
+ * @brief Transpozycja macierzy na surowych buforach
+ *
+ * Obie wersje dzielą macierz rekurencyjnie (cache-oblivious) aż do grup
+ * kafli 8×8, które transponuje jądro wektorowe z modułu simd. Nie są
+ * częścią publicznego API — korzystają z nich matrix::odwroc() i
+ * matrix::odwrocona().
+ */
+
+namespace transpozycja {
+
+    /**
+     * @brief Transponuje macierz w miejscu
+     * @param a Bufor macierzy (n*n elementów, wierszami)
+     * @param n Rozmiar macierzy
+     */
+    void w_miejscu(int* a, int n);
+
+    /**
+     * @brief Zapisuje transpozycję macierzy do osobnego bufora (B = A^T)
+     * @param a Bufor macierzy źródłowej (n*n elementów)
+     * @param b Bufor wynikowy (n*n elementów, nadpisywany, rozłączny z a)
+     * @param n Rozmiar macierzy
+     */
+    void poza_miejscem(const int* a, int* b, int n);
+}
+
+#endif
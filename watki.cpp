@@ -0,0 +1,197 @@
+/**
+ * @file watki.cpp
+ * @brief Implementacja puli wątków z podkradaniem zadań
+ */
+
+#include "watki.h"
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+
+namespace watki {
+
+    /// Wspólny stan zadań jednego wywołania rownolegle_dla
+    struct pula_watkow::grupa {
+        const std::function<void(int)>* funkcja;
+        std::atomic<int> pozostalo;   ///< Zmniejszane pod blokadą, by grupa żyła do powiadomienia
+        std::mutex blokada;
+        std::condition_variable gotowe; ///< Budzi wywołującego po ostatnim zadaniu
+        std::exception_ptr blad;
+    };
+
+    namespace {
+        /// Liczba zadań puli wykonywanych właśnie przez bieżący wątek
+        thread_local int zadania_w_toku = 0;
+
+        /// Oznacza bieżący wątek jako wykonujący zadanie puli
+        struct w_zadaniu {
+            w_zadaniu() { ++zadania_w_toku; }
+            ~w_zadaniu() { --zadania_w_toku; }
+            w_zadaniu(const w_zadaniu&) = delete;
+            w_zadaniu& operator=(const w_zadaniu&) = delete;
+        };
+    }
+
+    pula_watkow::pula_watkow(int liczba_watkow) {
+        if (liczba_watkow < 1) liczba_watkow = 1;
+        for (int i = 0; i < liczba_watkow - 1; ++i)
+            kolejki.push_back(std::make_unique<kolejka>());
+        for (int i = 0; i < liczba_watkow - 1; ++i)
+            robotnicy.emplace_back([this, i] { petla(i); });
+    }
+
+    pula_watkow::~pula_watkow() {
+        {
+            std::lock_guard<std::mutex> lock(blokada_snu);
+            koniec = true;
+        }
+        sen.notify_all();
+        for (auto& w : robotnicy) w.join();
+    }
+
+    /**
+     * @brief Pobiera zadanie: najpierw z końca własnej kolejki, potem podkrada
+     * @param wlasna Indeks własnej kolejki (-1 dla wątku wywołującego)
+     * @param z Pobrane zadanie
+     * @return true jeśli udało się pobrać zadanie
+     */
+    bool pula_watkow::pobierz(int wlasna, zadanie_t& z) {
+        if (oczekujace.load(std::memory_order_acquire) == 0) return false;
+        int ile = static_cast<int>(kolejki.size());
+        if (wlasna >= 0) {
+            kolejka& k = *kolejki[wlasna];
+            std::lock_guard<std::mutex> lock(k.blokada);
+            if (!k.zadania.empty()) {
+                z = k.zadania.back();
+                k.zadania.pop_back();
+                oczekujace.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        int start = wlasna >= 0 ? wlasna + 1 : 0;
+        for (int i = 0; i < ile; ++i) {
+            kolejka& k = *kolejki[(start + i) % ile];
+            std::lock_guard<std::mutex> lock(k.blokada);
+            if (!k.zadania.empty()) {
+                z = k.zadania.front();
+                k.zadania.pop_front();
+                oczekujace.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Wykonuje zadanie i zapamiętuje ewentualny wyjątek w grupie
+     * @param z Zadanie do wykonania
+     */
+    void pula_watkow::wykonaj(const zadanie_t& z) {
+        grupa& g = *z.g;
+        try {
+            w_zadaniu oznaczenie;
+            (*g.funkcja)(z.indeks);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(g.blokada);
+            if (!g.blad) g.blad = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(g.blokada);
+        if (g.pozostalo.fetch_sub(1, std::memory_order_acq_rel) == 1) g.gotowe.notify_all();
+    }
+
+    /**
+     * @brief Główna pętla wątku roboczego
+     * @param indeks Indeks kolejki wątku
+     */
+    void pula_watkow::petla(int indeks) {
+        zadanie_t z;
+        for (;;) {
+            if (pobierz(indeks, z)) {
+                wykonaj(z);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(blokada_snu);
+            sen.wait(lock, [this] { return koniec || oczekujace.load(std::memory_order_acquire) > 0; });
+            if (koniec) return;
+        }
+    }
+
+    void pula_watkow::rownolegle_dla(int liczba_zadan, const std::function<void(int)>& zadanie) {
+        if (liczba_zadan <= 0) return;
+        if (liczba_zadan == 1 || robotnicy.empty()) {
+            w_zadaniu oznaczenie;
+            for (int i = 0; i < liczba_zadan; ++i) zadanie(i);
+            return;
+        }
+
+        grupa g;
+        g.funkcja = &zadanie;
+        g.pozostalo.store(liczba_zadan, std::memory_order_relaxed);
+
+        // Zadania rozdzielane są po kolei między kolejki wątków roboczych
+        int ile = static_cast<int>(kolejki.size());
+        unsigned pierwsza = nastepna.fetch_add(1, std::memory_order_relaxed);
+        for (int i = 0; i < liczba_zadan; ++i) {
+            kolejka& k = *kolejki[(pierwsza + i) % ile];
+            std::lock_guard<std::mutex> lock(k.blokada);
+            k.zadania.push_back({ &g, i });
+        }
+        {
+            std::lock_guard<std::mutex> lock(blokada_snu);
+            oczekujace.fetch_add(liczba_zadan, std::memory_order_release);
+        }
+        sen.notify_all();
+
+        // Wątek wywołujący pomaga, dopóki są zadania w kolejkach, a potem
+        // śpi do zakończenia zadań wykonywanych jeszcze przez inne wątki
+        zadanie_t z;
+        while (g.pozostalo.load(std::memory_order_acquire) > 0 && pobierz(-1, z)) wykonaj(z);
+        std::unique_lock<std::mutex> lock(g.blokada);
+        g.gotowe.wait(lock, [&g] { return g.pozostalo.load(std::memory_order_acquire) == 0; });
+        std::exception_ptr blad = g.blad;
+        lock.unlock();
+        if (blad) std::rethrow_exception(blad);
+    }
+
+    namespace {
+        std::mutex blokada_globalnej;
+        std::shared_ptr<pula_watkow> pula_globalna;
+
+        /**
+         * @brief Domyślna liczba wątków: MATRIX_WATKI lub liczba rdzeni
+         */
+        int domyslna_liczba_watkow() {
+            if (const char* env = std::getenv("MATRIX_WATKI")) {
+                int wartosc = std::atoi(env);
+                if (wartosc > 0) return wartosc;
+            }
+            unsigned rdzenie = std::thread::hardware_concurrency();
+            return rdzenie > 0 ? static_cast<int>(rdzenie) : 1;
+        }
+    }
+
+    std::shared_ptr<pula_watkow> globalna() {
+        std::lock_guard<std::mutex> lock(blokada_globalnej);
+        if (!pula_globalna)
+            pula_globalna = std::make_shared<pula_watkow>(domyslna_liczba_watkow());
+        return pula_globalna;
+    }
+
+    void ustaw_liczbe_watkow(int liczba) {
+        if (zadania_w_toku > 0)
+            throw std::logic_error("Nie mozna zmienic liczby watkow z zadania puli");
+        if (liczba <= 0) liczba = domyslna_liczba_watkow();
+        std::shared_ptr<pula_watkow> stara;
+        {
+            std::lock_guard<std::mutex> lock(blokada_globalnej);
+            if (pula_globalna && pula_globalna->liczba_watkow() == liczba) return;
+            stara = std::move(pula_globalna);
+            pula_globalna = std::make_shared<pula_watkow>(liczba);
+        }
+    }
+
+    int liczba_watkow() {
+        return globalna()->liczba_watkow();
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef WATKI_H
+#define WATKI_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file watki.h
+ * @brief Pula wątków z podkradaniem zadań używana przez operacje na macierzach
+ *
+ * Biblioteka posiada jedną globalną pulę, tworzoną przy pierwszym użyciu.
+ * Liczbę wątków można ustawić zmienną środowiskową MATRIX_WATKI albo
+ * w czasie działania przez watki::ustaw_liczbe_watkow().
+ */
+
+namespace watki {
+
+    /**
+     * @class pula_watkow
+     * @brief Pula wątków roboczych z osobnymi kolejkami i podkradaniem zadań
+     *
+     * Każdy wątek roboczy ma własną kolejkę: zdejmuje zadania z jej końca,
+     * a gdy jest pusta, podkrada zadania z początku kolejek innych wątków.
+     * Wątek wywołujący rownolegle_dla() również wykonuje zadania, więc
+     * zagnieżdżone wywołania nie prowadzą do zakleszczenia. Gdy kolejki są
+     * puste, wywołujący czeka na zmiennej warunkowej grupy zamiast aktywnie.
+     */
+    class pula_watkow {
+    public:
+        /**
+         * @brief Tworzy pulę o podanej łącznej liczbie wątków
+         * @param liczba_watkow Liczba wątków łącznie z wywołującym (minimum 1)
+         */
+        explicit pula_watkow(int liczba_watkow);
+
+        /**
+         * @brief Zatrzymuje i dołącza wszystkie wątki robocze
+         */
+        ~pula_watkow();
+
+        pula_watkow(const pula_watkow&) = delete;
+        pula_watkow& operator=(const pula_watkow&) = delete;
+
+        /**
+         * @brief Zwraca łączną liczbę wątków (robocze + wywołujący)
+         * @return Liczba wątków
+         */
+        int liczba_watkow() const { return static_cast<int>(robotnicy.size()) + 1; }
+
+        /**
+         * @brief Wykonuje zadanie(i) dla i = 0..liczba_zadan-1 i czeka na zakończenie
+         * @details Pierwszy wyjątek zgłoszony przez zadanie jest przekazywany
+         * wywołującemu po zakończeniu pozostałych zadań.
+         * @param liczba_zadan Liczba zadań
+         * @param zadanie Funkcja wywoływana z indeksem zadania
+         */
+        void rownolegle_dla(int liczba_zadan, const std::function<void(int)>& zadanie);
+
+    private:
+        struct grupa;
+
+        /// Pojedyncze zadanie w kolejce
+        struct zadanie_t {
+            grupa* g;
+            int indeks;
+        };
+
+        /// Kolejka zadań jednego wątku
+        struct kolejka {
+            std::mutex blokada;
+            std::deque<zadanie_t> zadania;
+        };
+
+        bool pobierz(int wlasna, zadanie_t& z);
+        void wykonaj(const zadanie_t& z);
+        void petla(int indeks);
+
+        std::vector<std::unique_ptr<kolejka>> kolejki; ///< Kolejka każdego wątku roboczego
+        std::vector<std::thread> robotnicy;            ///< Wątki robocze
+        std::atomic<int> oczekujace{ 0 };              ///< Liczba zadań czekających w kolejkach
+        std::atomic<unsigned> nastepna{ 0 };           ///< Licznik rozdziału zadań między kolejki
+        std::mutex blokada_snu;                        ///< Blokada do usypiania wątków
+        std::condition_variable sen;                   ///< Budzenie wątków przy nowych zadaniach
+        bool koniec = false;                           ///< Sygnał zakończenia pracy puli
+    };
+
+    /**
+     * @brief Zwraca globalną pulę wątków biblioteki
+     * @details Pula jest tworzona przy pierwszym wywołaniu. Zwracany wskaźnik
+     * utrzymuje pulę przy życiu nawet po zmianie liczby wątków.
+     * @return Wskaźnik współdzielony na pulę
+     */
+    std::shared_ptr<pula_watkow> globalna();
+
+    /**
+     * @brief Zmienia liczbę wątków globalnej puli
+     * @param liczba Nowa liczba wątków; 0 przywraca wartość domyślną
+     * (MATRIX_WATKI lub liczba rdzeni)
+     * @throw std::logic_error Jeśli wywołana z zadania wykonywanego przez pulę
+     * (zniszczenie puli dołączałoby wątek, który właśnie ją wywołuje)
+     */
+    void ustaw_liczbe_watkow(int liczba);
+
+    /**
+     * @brief Zwraca liczbę wątków globalnej puli
+     * @return Liczba wątków
+     */
+    int liczba_watkow();
+}
+
+#endif
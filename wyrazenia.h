@@ -0,0 +1,224 @@
+#ifndef WYRAZENIA_H
+#define WYRAZENIA_H
+
+#include "matrix.h"
+#include <cstddef>
+#include <stdexcept>
+
+/**
+ * @file wyrazenia.h
+ * @brief Leniwe wyrażenia element po elemencie (szablony wyrażeń)
+ *
+ * Wyrażenie budowane od leniwie(m) nie tworzy macierzy tymczasowych:
+ * @code
+ * matrix wynik = (leniwie(m1) + m2) * 3 - 1;
+ * @endcode
+ * zapisuje wynik jednym przebiegiem po danych, bez pośrednich alokacji.
+ * Wyrażenie przechowuje wskaźniki do danych macierzy, więc macierze muszą
+ * istnieć do chwili przypisania wyniku. Zwykłe operatory klasy matrix
+ * pozostają zachłanne.
+ */
+
+namespace wyrazenia {
+
+    /**
+     * @class wyrazenie
+     * @brief Baza CRTP wszystkich węzłów wyrażenia
+     * @tparam E Typ konkretnego węzła
+     */
+    template <class E>
+    class wyrazenie {
+    public:
+        /**
+         * @brief Zwraca konkretny węzeł wyrażenia
+         * @return Referencja do węzła typu E
+         */
+        const E& self() const { return static_cast<const E&>(*this); }
+    };
+
+    /**
+     * @class lisc
+     * @brief Liść wyrażenia - widok tylko do odczytu na dane macierzy
+     */
+    class lisc : public wyrazenie<lisc> {
+    public:
+        /**
+         * @brief Tworzy widok na dane macierzy
+         * @param m Macierz (musi istnieć do obliczenia wyrażenia)
+         */
+        explicit lisc(const matrix& m) : dane(m.macierz_ptr.get()), n(m.n) {}
+
+        /**
+         * @brief Zwraca rozmiar macierzy
+         * @return Rozmiar n (dla macierzy n×n)
+         */
+        int rozmiar() const { return n; }
+
+        /**
+         * @brief Zwraca i-ty element (indeks liniowy, wierszami)
+         * @param i Indeks elementu
+         * @return Wartość elementu
+         */
+        int operator[](std::size_t i) const { return dane[i]; }
+
+    private:
+        const int* dane; ///< Dane macierzy
+        int n;           ///< Rozmiar macierzy
+    };
+
+    // ==================== Działania ====================
+    // Arytmetyka modulo 2^32, tak jak w jądrach wektorowych
+
+    /// Dodawanie
+    struct suma {
+        static int licz(int x, int y) { return static_cast<int>(static_cast<unsigned>(x) + static_cast<unsigned>(y)); }
+    };
+
+    /// Odejmowanie
+    struct roznica {
+        static int licz(int x, int y) { return static_cast<int>(static_cast<unsigned>(x) - static_cast<unsigned>(y)); }
+    };
+
+    /// Mnożenie
+    struct iloczyn {
+        static int licz(int x, int y) { return static_cast<int>(static_cast<unsigned>(x) * static_cast<unsigned>(y)); }
+    };
+
+    // ==================== Węzły ====================
+
+    /**
+     * @class dwa_argumenty
+     * @brief Węzeł działania na dwóch wyrażeniach tego samego rozmiaru
+     */
+    template <class L, class R, class Op>
+    class dwa_argumenty : public wyrazenie<dwa_argumenty<L, R, Op>> {
+    public:
+        /**
+         * @brief Tworzy węzeł
+         * @throw std::logic_error Jeśli argumenty mają różne rozmiary
+         */
+        dwa_argumenty(const L& l, const R& r) : l(l), r(r) {
+            if (l.rozmiar() != r.rozmiar())
+                throw std::logic_error("Macierze muszą mieć ten sam rozmiar");
+        }
+
+        int rozmiar() const { return l.rozmiar(); }
+        int operator[](std::size_t i) const { return Op::licz(l[i], r[i]); }
+
+    private:
+        L l; ///< Lewy argument
+        R r; ///< Prawy argument
+    };
+
+    /**
+     * @class ze_skalarem
+     * @brief Węzeł działania wyrażenie op skalar
+     */
+    template <class L, class Op>
+    class ze_skalarem : public wyrazenie<ze_skalarem<L, Op>> {
+    public:
+        ze_skalarem(const L& l, int a) : l(l), a(a) {}
+
+        int rozmiar() const { return l.rozmiar(); }
+        int operator[](std::size_t i) const { return Op::licz(l[i], a); }
+
+    private:
+        L l;   ///< Wyrażenie
+        int a; ///< Skalar
+    };
+
+    /**
+     * @class skalar_z
+     * @brief Węzeł działania skalar op wyrażenie
+     */
+    template <class R, class Op>
+    class skalar_z : public wyrazenie<skalar_z<R, Op>> {
+    public:
+        skalar_z(int a, const R& r) : a(a), r(r) {}
+
+        int rozmiar() const { return r.rozmiar(); }
+        int operator[](std::size_t i) const { return Op::licz(a, r[i]); }
+
+    private:
+        int a; ///< Skalar
+        R r;   ///< Wyrażenie
+    };
+
+    // ==================== Operatory ====================
+
+    template <class L, class R>
+    dwa_argumenty<L, R, suma> operator+(const wyrazenie<L>& l, const wyrazenie<R>& r) {
+        return { l.self(), r.self() };
+    }
+
+    template <class L>
+    dwa_argumenty<L, lisc, suma> operator+(const wyrazenie<L>& l, const matrix& r) {
+        return { l.self(), lisc(r) };
+    }
+
+    template <class R>
+    dwa_argumenty<lisc, R, suma> operator+(const matrix& l, const wyrazenie<R>& r) {
+        return { lisc(l), r.self() };
+    }
+
+    template <class L, class R>
+    dwa_argumenty<L, R, roznica> operator-(const wyrazenie<L>& l, const wyrazenie<R>& r) {
+        return { l.self(), r.self() };
+    }
+
+    template <class L>
+    dwa_argumenty<L, lisc, roznica> operator-(const wyrazenie<L>& l, const matrix& r) {
+        return { l.self(), lisc(r) };
+    }
+
+    template <class R>
+    dwa_argumenty<lisc, R, roznica> operator-(const matrix& l, const wyrazenie<R>& r) {
+        return { lisc(l), r.self() };
+    }
+
+    template <class L>
+    ze_skalarem<L, suma> operator+(const wyrazenie<L>& l, int a) {
+        return { l.self(), a };
+    }
+
+    template <class R>
+    skalar_z<R, suma> operator+(int a, const wyrazenie<R>& r) {
+        return { a, r.self() };
+    }
+
+    template <class L>
+    ze_skalarem<L, roznica> operator-(const wyrazenie<L>& l, int a) {
+        return { l.self(), a };
+    }
+
+    template <class R>
+    skalar_z<R, roznica> operator-(int a, const wyrazenie<R>& r) {
+        return { a, r.self() };
+    }
+
+    template <class L>
+    ze_skalarem<L, iloczyn> operator*(const wyrazenie<L>& l, int a) {
+        return { l.self(), a };
+    }
+
+    template <class R>
+    skalar_z<R, iloczyn> operator*(int a, const wyrazenie<R>& r) {
+        return { a, r.self() };
+    }
+
+    template <class R>
+    skalar_z<R, roznica> operator-(const wyrazenie<R>& r) {
+        return { 0, r.self() };
+    }
+}
+
+/**
+ * @brief Rozpoczyna leniwe wyrażenie na macierzy
+ * @param m Macierz (musi istnieć do obliczenia wyrażenia)
+ * @return Liść wyrażenia
+ */
+inline wyrazenia::lisc leniwie(const matrix& m) {
+    return wyrazenia::lisc(m);
+}
+
+#endif